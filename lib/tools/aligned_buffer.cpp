@@ -0,0 +1,61 @@
+#include <tools/aligned_buffer.hpp>
+
+#include <new>
+#include <utility>
+#include <cassert>
+
+
+tools::AlignedBuffer::AlignedBuffer(size_t size, size_t alignment)
+    : m_alignment(alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be power of 2");
+    reserve(size);
+}
+
+
+tools::AlignedBuffer::~AlignedBuffer() noexcept
+{
+    release();
+}
+
+
+tools::AlignedBuffer::AlignedBuffer(AlignedBuffer &&inst) noexcept
+    : m_data(std::exchange(inst.m_data, nullptr))
+    , m_size(std::exchange(inst.m_size, 0))
+    , m_alignment(inst.m_alignment)
+{
+}
+
+
+tools::AlignedBuffer &tools::AlignedBuffer::operator=(AlignedBuffer &&inst) noexcept
+{
+    if (this != &inst) {
+        release();
+        m_data = std::exchange(inst.m_data, nullptr);
+        m_size = std::exchange(inst.m_size, 0);
+        m_alignment = inst.m_alignment;
+    }
+    return *this;
+}
+
+
+void tools::AlignedBuffer::reserve(size_t size)
+{
+    if (size <= m_size) {
+        return;
+    }
+
+    release();
+    m_data = static_cast<char*>(::operator new(size, std::align_val_t(m_alignment)));
+    m_size = size;
+}
+
+
+void tools::AlignedBuffer::release() noexcept
+{
+    if (m_data != nullptr) {
+        ::operator delete(m_data, std::align_val_t(m_alignment));
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
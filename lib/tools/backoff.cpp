@@ -0,0 +1,40 @@
+#include <tools/backoff.hpp>
+
+#include <thread>
+#include <chrono>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TOOLS_CPU_RELAX() _mm_pause()
+#else
+#define TOOLS_CPU_RELAX() ((void)0)
+#endif
+
+
+namespace {
+
+constexpr const size_t kSpinSteps = 64;
+constexpr const size_t kYieldSteps = kSpinSteps + 64;
+constexpr const auto kSleepPeriod = std::chrono::microseconds(50);
+
+} // ns anonymous
+
+
+void tools::Backoff::pause()
+{
+    if (m_step < kSpinSteps) {
+        TOOLS_CPU_RELAX();
+    } else if (m_step < kYieldSteps) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(kSleepPeriod);
+        return;
+    }
+    ++m_step;
+}
+
+
+void tools::Backoff::reset()
+{
+    m_step = 0;
+}
@@ -0,0 +1,193 @@
+#include <tools/cpu_dispatch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define TOOLS_CPU_X86 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define TOOLS_CPU_X86 1
+#else
+#define TOOLS_CPU_X86 0
+#endif
+
+
+namespace {
+
+#if TOOLS_CPU_X86
+
+struct CpuIdRegs {
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+};
+
+
+bool cpuid(uint32_t leaf, uint32_t subLeaf, CpuIdRegs& regs)
+{
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (static_cast<uint32_t>(info[0]) < leaf) {
+        return false;
+    }
+    __cpuidex(info, leaf, subLeaf);
+    regs.eax = info[0];
+    regs.ebx = info[1];
+    regs.ecx = info[2];
+    regs.edx = info[3];
+    return true;
+#else
+    if (__get_cpuid_max(0, nullptr) < leaf) {
+        return false;
+    }
+    __cpuid_count(leaf, subLeaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+    return true;
+#endif
+}
+
+
+/// OS enabled registers state (XCR0)
+uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+
+tools::cpu::Features detect()
+{
+    tools::cpu::Features res;
+
+#if TOOLS_CPU_X86
+    constexpr const uint64_t kXcr0SseAvxState = 0x6;       // XMM | YMM
+    constexpr const uint64_t kXcr0Avx512State = 0xe6;      // XMM | YMM | opmask | ZMM_Hi256 | Hi16_ZMM
+
+    CpuIdRegs regs;
+    if (!cpuid(1, 0, regs)) {
+        return res;
+    }
+
+    res.sse2 = (regs.edx & (1u << 26)) != 0;
+
+    const bool osxsave = (regs.ecx & (1u << 27)) != 0;
+    const bool avx = (regs.ecx & (1u << 28)) != 0;
+    const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+
+    res.avx = avx && ((xcr0 & kXcr0SseAvxState) == kXcr0SseAvxState);
+
+    if (cpuid(7, 0, regs)) {
+        res.avx2 = res.avx && (regs.ebx & (1u << 5)) != 0;
+        res.avx512f = res.avx && (regs.ebx & (1u << 16)) != 0
+                && ((xcr0 & kXcr0Avx512State) == kXcr0Avx512State);
+    }
+#endif
+
+    return res;
+}
+
+
+std::atomic<tools::cpu::Isa> gIsaLimit(tools::cpu::Isa::AVX512);
+
+} // ns a
+
+
+const tools::cpu::Features &tools::cpu::detectedFeatures()
+{
+    static const Features inst = detect();
+    return inst;
+}
+
+
+tools::cpu::Isa tools::cpu::detectedIsa()
+{
+    const auto& features = detectedFeatures();
+    if (features.avx512f) {
+        return Isa::AVX512;
+    }
+    if (features.avx2) {
+        return Isa::AVX2;
+    }
+    if (features.sse2) {
+        return Isa::SSE2;
+    }
+    return Isa::Scalar;
+}
+
+
+void tools::cpu::setIsaLimit(Isa isa)
+{
+    gIsaLimit = isa;
+}
+
+
+tools::cpu::Isa tools::cpu::isaLimit()
+{
+    return gIsaLimit;
+}
+
+
+tools::cpu::Isa tools::cpu::effectiveIsa()
+{
+    return std::min(detectedIsa(), isaLimit());
+}
+
+
+const char *tools::cpu::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar:
+        return "scalar";
+    case Isa::SSE2:
+        return "sse2";
+    case Isa::AVX2:
+        return "avx2";
+    case Isa::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+
+tools::cpu::Isa tools::cpu::parseIsa(const std::string &name)
+{
+    for(const auto isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (name == isaName(isa)) {
+            return isa;
+        }
+    }
+    throw std::runtime_error("unknown instruction set: " + name);
+}
+
+
+std::string tools::cpu::featuresStringRepresentation(const Features &features)
+{
+    std::string res;
+    const auto add = [&res](bool has, const char* name) {
+        if (has) {
+            if (!res.empty()) {
+                res += " ";
+            }
+            res += name;
+        }
+    };
+    add(features.sse2, "sse2");
+    add(features.avx, "avx");
+    add(features.avx2, "avx2");
+    add(features.avx512f, "avx512f");
+    return res.empty() ? std::string("-") : res;
+}
@@ -1,5 +1,7 @@
 #include <tools/hash/abstract_hasher.hpp>
 
+#include <array>
+
 
 void tools::hash::AbstractHasher::initialize()
 {
@@ -26,12 +28,46 @@ tools::hash::AbstractHasher::AbstractHasher()
 
 tools::hash::Digest tools::hash::AbstractHasher::hash(const std::string_view &buffer)
 {
+    return doHash(buffer);
+}
+
+
+tools::hash::Digest tools::hash::AbstractHasher::doHash(const std::string_view &buffer)
+{
+    // default: via iterational intf
     initialize();
     process(buffer);
     return finalize();
 }
 
 
+void tools::hash::AbstractHasher::hashMany(const std::string_view *buffers, size_t count, Digest *digests)
+{
+    doHashMany(buffers, count, digests);
+}
+
+
+size_t tools::hash::AbstractHasher::batchSizeHint() const
+{
+    return doGetBatchSizeHint();
+}
+
+
+void tools::hash::AbstractHasher::doHashMany(const std::string_view *buffers, size_t count, Digest *digests)
+{
+    // default: one by one
+    for(size_t i = 0; i < count; ++i) {
+        digests[i] = hash(buffers[i]);
+    }
+}
+
+
+size_t tools::hash::AbstractHasher::doGetBatchSizeHint() const
+{
+    return 1;
+}
+
+
 size_t tools::hash::AbstractHasherFactory::digestSize()
 {
     return doGetDigestSize();
@@ -53,12 +89,27 @@ size_t tools::hash::AbstractHasherFactory::doGetDigestSize()
     m_digestSize =
             std::max<tools::SizeBytes>(
                 1,
-                digest.binary.size());
+                digest.size());
 
     return m_digestSize;
 }
 
 
+size_t tools::hash::AbstractHasherFactory::batchSizeHint()
+{
+    return doGetBatchSizeHint();
+}
+
+
+size_t tools::hash::AbstractHasherFactory::doGetBatchSizeHint()
+{
+    if (m_batchSizeHint == 0) {
+        m_batchSizeHint = std::max<size_t>(1, create()->batchSizeHint());
+    }
+    return m_batchSizeHint;
+}
+
+
 tools::hash::HasherPtr tools::hash::AbstractHasherFactory::create()
 {
     return doCreate();
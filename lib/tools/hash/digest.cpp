@@ -1,8 +1,10 @@
 #include <tools/hash/digest.hpp>
 
+#include <tools/hash/hex.hpp>
+
 #include <ios>
-#include <iomanip>
 #include <cassert>
+#include <stdexcept>
 
 
 tools::hash::Digest::Digest(const tools::Byte* data, size_t size)
@@ -23,7 +25,7 @@ tools::hash::Digest &tools::hash::Digest::operator=(const std::string_view &buff
             ? buffer.size()
             : 0;
 
-    binary.resize(N);
+    resize(N);
     if (N > 0) {
         std::copy(buffer.begin(), buffer.end(), binary.begin());
     }
@@ -31,14 +33,21 @@ tools::hash::Digest &tools::hash::Digest::operator=(const std::string_view &buff
 }
 
 
-std::ostream &tools::hash::operator<<(std::ostream &stream, const Digest &digest)
+void tools::hash::Digest::resize(size_t size)
 {
-    for(const auto& b : digest.binary) {
-        stream << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
+    if (size > kMaxSize) {
+        throw std::length_error("digest size is greater then supported");
     }
+    binarySize = static_cast<uint8_t>(size);
+}
 
+
+std::ostream &tools::hash::operator<<(std::ostream &stream, const Digest &digest)
+{
     // NOTE: avoid flushing on every short digest, also use same delimiter for all platforms ("binary compat" text files)
-    stream << "\n"; // std::endl;
+    char line[2 * Digest::kMaxSize + 1];
+    const size_t size = encodeHexLines(&digest, 1, line);
+    stream.write(line, static_cast<std::streamsize>(size));
 
     return stream;
 }
@@ -0,0 +1,123 @@
+#include <tools/hash/hex.hpp>
+
+#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace {
+
+/// byte => 2 lowercase hex chars
+struct HexTable {
+    std::array<char, 512> chars;
+
+    constexpr HexTable()
+        : chars()
+    {
+        constexpr const char kDigits[] = "0123456789abcdef";
+        for(size_t i = 0; i < 256; ++i) {
+            chars[2 * i] = kDigits[i >> 4];
+            chars[2 * i + 1] = kDigits[i & 0x0F];
+        }
+    }
+};
+
+constexpr const HexTable kHexTable;
+
+
+inline char* encodeScalar(const tools::Byte* data, size_t size, char* out) noexcept
+{
+    for(size_t i = 0; i < size; ++i) {
+        const char* chars = &kHexTable.chars[2 * data[i]];
+        out[0] = chars[0];
+        out[1] = chars[1];
+        out += 2;
+    }
+    return out;
+}
+
+
+#if defined(__SSE2__)
+
+/// 16 bytes => 32 hex chars: nibbles to '0'-'9' or 'a'-'f', then interleave high and low ones
+inline char* encode16(const tools::Byte* data, char* out) noexcept
+{
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i digitsBase = _mm_set1_epi8('0');
+    const __m128i lettersOffset = _mm_set1_epi8('a' - '0' - 10);
+
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask);
+    const __m128i low = _mm_and_si128(bytes, lowMask);
+
+    const auto toChars = [&](__m128i nibbles) {
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine), lettersOffset);
+        return _mm_add_epi8(_mm_add_epi8(nibbles, digitsBase), letters);
+    };
+
+    const __m128i highChars = toChars(high);
+    const __m128i lowChars = toChars(low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(highChars, lowChars));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(highChars, lowChars));
+    return out + 32;
+}
+
+#endif
+
+
+/// hex char => nibble, -1 if not hex
+inline int decodeNibble(char c) noexcept
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+} // ns anonymous
+
+
+size_t tools::hash::encodeHexLines(const Digest *digests, size_t count, char *out) noexcept
+{
+    char* const begin = out;
+    for(size_t i = 0; i < count; ++i) {
+        const Byte* data = digests[i].data();
+        size_t size = digests[i].size();
+
+#if defined(__SSE2__)
+        for(; size >= 16; size -= 16, data += 16) {
+            out = encode16(data, out);
+        }
+#endif
+        out = encodeScalar(data, size, out);
+        *out++ = '\n';
+    }
+    return static_cast<size_t>(out - begin);
+}
+
+
+bool tools::hash::decodeHex(std::string_view text, Byte *out) noexcept
+{
+    if (text.size() % 2 != 0) {
+        return false;
+    }
+
+    for(size_t i = 0; i < text.size(); i += 2) {
+        const int high = decodeNibble(text[i]);
+        const int low = decodeNibble(text[i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        *out++ = static_cast<Byte>((high << 4) | low);
+    }
+    return true;
+}
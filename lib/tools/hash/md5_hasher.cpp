@@ -8,27 +8,32 @@
  */
 
 #include <tools/hash/md5_hasher.hpp>
+#include <tools/hash/md5_multi_hasher.hpp>
 
 
 #include <cstdint>
 #include <cstring>
 #include <cassert>
+#include <array>
 
 namespace {
 
-#ifdef _WIN32
-// TODO 0: improove detection for arm etc
+// byte order is known to compiler, arch guessing only as fallback
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 #define HASHER_MD5_LE_CPU 1
 #define HASHER_MD5_BE_CPU 0
 #else
-#if defined(__i386__) || defined(__x86_64__) || defined(__vax__)
+#define HASHER_MD5_LE_CPU 0
+#define HASHER_MD5_BE_CPU 1
+#endif
+#elif defined(_WIN32) || defined(__i386__) || defined(__x86_64__) || defined(__vax__)
 #define HASHER_MD5_LE_CPU 1
 #define HASHER_MD5_BE_CPU 0
 #else
 #define HASHER_MD5_LE_CPU 0
 #define HASHER_MD5_BE_CPU 1
 #endif
-#endif
 
 using MD5_u32 = uint32_t;
 using MD5_Size = unsigned long;
@@ -37,6 +42,16 @@ using MD5_Size = unsigned long;
 constexpr const MD5_Size kMD5DataBlockSizeBytes = 64;
 constexpr const MD5_Size kMD5DigestSize = 4 * sizeof(MD5_u32);
 
+/// partly filled SIMD group used if at least 1/N of lanes are busy, else scalar is faster
+constexpr const size_t kMultiBufferMinLanesFillDivisor = 4;
+
+
+const tools::hash::md5::MultiBufferHasher& sharedMultiBufferHasher()
+{
+    static const tools::hash::md5::MultiBufferHasher inst;
+    return inst;
+}
+
 
 struct MD5_State {
     MD5_u32 a = 0x67452301;
@@ -45,6 +60,30 @@ struct MD5_State {
     MD5_u32 d = 0x10325476;
 };
 
+
+/**
+ * @brief final padding block for message of fixed size multiple of 64: 0x80, zeros, size in bits (LE)
+ */
+template<MD5_Size MessageSizeBytes>
+constexpr std::array<unsigned char, kMD5DataBlockSizeBytes> makeFixedSizePaddingBlock()
+{
+    static_assert((MessageSizeBytes % kMD5DataBlockSizeBytes) == 0, "message must be whole count of blocks");
+
+    std::array<unsigned char, kMD5DataBlockSizeBytes> res{};
+    res[0] = 0x80;
+
+    const uint64_t sizeBits = static_cast<uint64_t>(MessageSizeBytes) << 3;
+    for(size_t i = 0; i < 8; ++i) {
+        res[kMD5DataBlockSizeBytes - 8 + i] = static_cast<unsigned char>(sizeBits >> (8 * i));
+    }
+    return res;
+}
+
+
+template<MD5_Size MessageSizeBytes>
+constexpr const std::array<unsigned char, kMD5DataBlockSizeBytes> kFixedSizePaddingBlock =
+        makeFixedSizePaddingBlock<MessageSizeBytes>();
+
 } // ns a
 
 
@@ -126,6 +165,11 @@ struct HasherPrivate {
     std::array<MD5_u32, kMD5DataBlockSizeBytes / sizeof(MD5_u32)> buffer;
 #endif
 
+    /// specialised one shot path for blocks of fixed size, @see FixedSizeHasher
+    using FixedSizeHashFunc = void (HasherPrivate::*)(const Byte* data, Byte* result);
+    FixedSizeHashFunc fixedSizeHash = nullptr;
+    MD5_Size fixedSizeBytes = 0;
+
     HasherPrivate(Hasher* q_ptr)
         : q_ptr(q_ptr)
     {
@@ -323,6 +367,48 @@ struct HasherPrivate {
         reinit();
     }
 
+
+    /// one shot hashing of whole buffer
+    void hash(const std::string_view& buffer, Digest& digest)
+    {
+        digest.resize(kMD5DigestSize);
+
+        if (fixedSizeHash != nullptr && buffer.size() == fixedSizeBytes) {
+            (this->*fixedSizeHash)(reinterpret_cast<const Byte*>(buffer.data()), digest.data());
+            return;
+        }
+
+        reinit();
+        updateArbitarySizedBuffer(buffer.data(), buffer.size());
+        finalize(digest.data());
+    }
+
+
+    /// one shot hashing of fixed size block: no counters, no partial buffers, constexpr padding
+    template<MD5_Size BlockSizeBytes>
+    void hashFixedSize(const Byte* data, Byte* result)
+    {
+        state = MD5_State();
+
+        updateBlocks(data, BlockSizeBytes);
+        updateBlocks(kFixedSizePaddingBlock<BlockSizeBytes>.data(), kMD5DataBlockSizeBytes);
+
+        pushU32ToBuffer(result +  0, state.a);
+        pushU32ToBuffer(result +  4, state.b);
+        pushU32ToBuffer(result +  8, state.c);
+        pushU32ToBuffer(result + 12, state.d);
+
+        state = MD5_State();
+    }
+
+
+    template<MD5_Size BlockSizeBytes>
+    void setupFixedSize()
+    {
+        fixedSizeHash = &HasherPrivate::hashFixedSize<BlockSizeBytes>;
+        fixedSizeBytes = BlockSizeBytes;
+    }
+
 };
 
 // \-- end of copy of [1]
@@ -337,6 +423,29 @@ tools::hash::md5::Hasher::Hasher()
 }
 
 
+tools::hash::md5::Hasher::Hasher(size_t fixedBlockSizeBytes)
+    : Hasher()
+{
+    switch (fixedBlockSizeBytes) {
+    case 512:
+        d_ptr->setupFixedSize<512>();
+        break;
+    case 4 * 1024:
+        d_ptr->setupFixedSize<4 * 1024>();
+        break;
+    case 64 * 1024:
+        d_ptr->setupFixedSize<64 * 1024>();
+        break;
+    case 1024 * 1024:
+        d_ptr->setupFixedSize<1024 * 1024>();
+        break;
+    default:
+        assert(!isFixedBlockSizeSpecialised(fixedBlockSizeBytes) && "specialisation not bound");
+        break;
+    }
+}
+
+
 tools::hash::md5::Hasher::~Hasher()
 {
     // for d_ptr
@@ -358,13 +467,75 @@ void tools::hash::md5::Hasher::doProcess(const std::string_view &buffer)
 tools::hash::Digest tools::hash::md5::Hasher::doFinalize()
 {
     tools::hash::Digest res;
-    res.binary.resize(kMD5DigestSize);
-    d_ptr->finalize(res.binary.data());
+    res.resize(kMD5DigestSize);
+    d_ptr->finalize(res.data());
+    return res;
+}
+
+
+tools::hash::Digest tools::hash::md5::Hasher::doHash(const std::string_view &buffer)
+{
+    tools::hash::Digest res;
+    d_ptr->hash(buffer, res);
     return res;
 }
 
 
+void tools::hash::md5::Hasher::doHashMany(const std::string_view *buffers, size_t count, Digest *digests)
+{
+    const auto& multiBuffer = sharedMultiBufferHasher();
+    const size_t lanes = multiBuffer.lanes();
+
+    size_t i = 0;
+    while (i < count) {
+        // SIMD lanes run in lockstep => find run of same sized buffers
+        size_t runEnd = i + 1;
+        while (runEnd < count && buffers[runEnd].size() == buffers[i].size()) {
+            ++runEnd;
+        }
+
+        if (lanes > 1) {
+            const size_t runSize = runEnd - i;
+            const size_t restSize = runSize % lanes;
+            const size_t simdCount = runSize - restSize
+                    + ((restSize * kMultiBufferMinLanesFillDivisor >= lanes) ? restSize : 0);
+            if (simdCount > 0) {
+                multiBuffer.hash(buffers + i, simdCount, digests + i);
+                i += simdCount;
+            }
+        }
+
+        // NOTE: no virtual calls per block
+        for(; i < runEnd; ++i) {
+            d_ptr->hash(buffers[i], digests[i]);
+        }
+    }
+}
+
+
+size_t tools::hash::md5::Hasher::doGetBatchSizeHint() const
+{
+    return sharedMultiBufferHasher().lanes();
+}
+
+
 size_t tools::hash::md5::HasherFactory::doGetDigestSize()
 {
     return kMD5DigestSize;
 }
+
+
+tools::hash::HasherFactoryPtr tools::hash::md5::createHasherFactory(size_t blockSizeBytes)
+{
+    switch (blockSizeBytes) {
+    case 512:
+        return std::make_shared<FixedSizeHasherFactory<512>>();
+    case 4 * 1024:
+        return std::make_shared<FixedSizeHasherFactory<4 * 1024>>();
+    case 64 * 1024:
+        return std::make_shared<FixedSizeHasherFactory<64 * 1024>>();
+    case 1024 * 1024:
+        return std::make_shared<FixedSizeHasherFactory<1024 * 1024>>();
+    }
+    return std::make_shared<HasherFactory>();
+}
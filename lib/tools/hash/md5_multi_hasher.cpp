@@ -0,0 +1,113 @@
+#include <tools/hash/md5_multi_hasher.hpp>
+
+#include <cassert>
+#include <algorithm>
+
+#include <tools/cpu_dispatch.hpp>
+
+#include "md5_multi_kernels.hpp"
+
+
+namespace tools {
+namespace hash {
+namespace md5 {
+namespace detail {
+
+constexpr const size_t kMaxLanes = 16;
+
+
+struct KernelVariant {
+    tools::cpu::Isa isa;
+    size_t lanes;
+    MultiBufferKernel kernel;
+};
+
+
+/// compiled kernels, most preferable first
+constexpr const KernelVariant kKernelVariants[] = {
+#if TOOLS_HASH_MD5_MB_X86
+    {tools::cpu::Isa::AVX512, 16, &md5MultiBufferKernelAvx512},
+    {tools::cpu::Isa::AVX2,    8, &md5MultiBufferKernelAvx2},
+    {tools::cpu::Isa::SSE2,    4, &md5MultiBufferKernelSse2},
+#endif
+    {tools::cpu::Isa::Scalar,  1, nullptr},
+};
+
+
+struct MultiBufferHasherPrivate {
+    MultiBufferKernel kernel = nullptr;
+    size_t lanes = 1;
+    tools::cpu::Isa isa = tools::cpu::Isa::Scalar;
+
+    MultiBufferHasherPrivate()
+    {
+        // bind fastest compiled variant runnable on this CPU
+        const auto maxIsa = tools::cpu::effectiveIsa();
+        for(const auto& variant : kKernelVariants) {
+            if (variant.isa <= maxIsa) {
+                kernel = variant.kernel;
+                lanes = variant.lanes;
+                isa = variant.isa;
+                break;
+            }
+        }
+        assert(lanes <= kMaxLanes && "too many lanes");
+    }
+};
+
+}}}} // ns tools::hash::md5::detail
+
+
+tools::hash::md5::MultiBufferHasher::MultiBufferHasher()
+    : d_ptr(new detail::MultiBufferHasherPrivate())
+{
+}
+
+
+tools::hash::md5::MultiBufferHasher::~MultiBufferHasher()
+{
+    // for d_ptr
+}
+
+
+size_t tools::hash::md5::MultiBufferHasher::lanes() const
+{
+    return d_ptr->lanes;
+}
+
+
+const char *tools::hash::md5::MultiBufferHasher::kernelName() const
+{
+    return tools::cpu::isaName(d_ptr->isa);
+}
+
+
+void tools::hash::md5::MultiBufferHasher::hash(const std::string_view *buffers, size_t count, Digest *digests) const
+{
+    assert(d_ptr->kernel != nullptr && "no multi-buffer kernel available");
+
+    const size_t lanes = d_ptr->lanes;
+
+    const unsigned char* data[detail::kMaxLanes];
+    unsigned char results[detail::kMaxLanes * detail::kMultiBufferDigestSize];
+
+    for(size_t first = 0; first < count; first += lanes) {
+        const size_t n = std::min(lanes, count - first);
+        const size_t size = buffers[first].size();
+
+        for(size_t lane = 0; lane < lanes; ++lane) {
+            // not used lanes just duplicate first one
+            const auto& buffer = buffers[first + (lane < n ? lane : 0)];
+            assert(buffer.size() == size && "buffers must be same size");
+            data[lane] = reinterpret_cast<const unsigned char*>(buffer.data());
+        }
+
+        d_ptr->kernel(data, size, results);
+
+        for(size_t i = 0; i < n; ++i) {
+            auto& digest = digests[first + i];
+            digest.resize(detail::kMultiBufferDigestSize);
+            std::copy_n(results + i * detail::kMultiBufferDigestSize, detail::kMultiBufferDigestSize, digest.data());
+        }
+    }
+}
@@ -0,0 +1,243 @@
+/**
+ *  Multi-buffer MD5 kernel body. Hashes MD5_MB_LANES equal sized buffers in lockstep,
+ *  each SIMD lane holds state of its own buffer.
+ *
+ *  Include it into kernel translation unit compiled with proper ISA flags (-mavx2 etc), define before include:
+ *      MD5_MB_LANES       - lanes count (vector width in 32-bit words)
+ *      MD5_MB_KERNEL_FUNC - name of kernel function to define, @see md5_multi_kernels.hpp
+ *
+ *  NOTE: do not include any std headers with inline code here - kernel TU compiled with extended ISA
+ *  and linker may choose such inline instantiation for all other TUs
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "md5_multi_kernels.hpp"
+
+#ifndef MD5_MB_LANES
+#error "MD5_MB_LANES must be defined"
+#endif
+#ifndef MD5_MB_KERNEL_FUNC
+#error "MD5_MB_KERNEL_FUNC must be defined"
+#endif
+
+
+namespace {
+
+using MD5_u32 = uint32_t;
+
+// GCC/Clang vector extension, compiler maps it to ISA given to TU
+typedef MD5_u32 MD5_Vec __attribute__((vector_size(MD5_MB_LANES * sizeof(MD5_u32))));
+
+constexpr const size_t kMD5DataBlockSizeBytes = 64;
+constexpr const size_t kMD5BlockWords = kMD5DataBlockSizeBytes / sizeof(MD5_u32);
+
+
+struct MD5_VecState {
+    MD5_Vec a;
+    MD5_Vec b;
+    MD5_Vec c;
+    MD5_Vec d;
+};
+
+
+inline MD5_u32 loadU32LE(const unsigned char* p) noexcept
+{
+    return (static_cast<MD5_u32>(p[0]) <<  0)
+         | (static_cast<MD5_u32>(p[1]) <<  8)
+         | (static_cast<MD5_u32>(p[2]) << 16)
+         | (static_cast<MD5_u32>(p[3]) << 24);
+}
+
+
+inline void storeU32LE(unsigned char* p, MD5_u32 v) noexcept
+{
+    p[0] = static_cast<unsigned char>(v >>  0);
+    p[1] = static_cast<unsigned char>(v >>  8);
+    p[2] = static_cast<unsigned char>(v >> 16);
+    p[3] = static_cast<unsigned char>(v >> 24);
+}
+
+
+/*
+ * Same basic functions as in scalar impl (see md5_hasher.cpp), but on vectors
+ */
+#define MB_F(x, y, z)            ((z) ^ ((x) & ((y) ^ (z))))
+#define MB_G(x, y, z)            ((y) ^ ((z) & ((x) ^ (y))))
+#define MB_H(x, y, z)            (((x) ^ (y)) ^ (z))
+#define MB_I(x, y, z)            ((y) ^ ((x) | ~(z)))
+
+#define MB_ROUND_STEP(f, a, b, c, d, x, t, s) \
+    (a) += f((b), (c), (d)) + (x) + static_cast<MD5_u32>(t); \
+    (a) = ((a) << (s)) | ((a) >> (32 - (s))); \
+    (a) += (b);
+
+
+/**
+ * @brief transpose single 64-byte block of each lane: W[j][lane] = word j of lane data
+ */
+inline void loadMessageWords(MD5_Vec* W, const unsigned char* const* ptrs, size_t offset) noexcept
+{
+    alignas(64) MD5_u32 words[kMD5BlockWords][MD5_MB_LANES];
+    for(size_t lane = 0; lane < MD5_MB_LANES; ++lane) {
+        const unsigned char* p = ptrs[lane] + offset;
+        for(size_t j = 0; j < kMD5BlockWords; ++j) {
+            words[j][lane] = loadU32LE(p + j * sizeof(MD5_u32));
+        }
+    }
+    for(size_t j = 0; j < kMD5BlockWords; ++j) {
+        memcpy(&W[j], words[j], sizeof(MD5_Vec));
+    }
+}
+
+
+void updateBlocks(MD5_VecState& state, const unsigned char* const* ptrs, size_t blocksCount) noexcept
+{
+    MD5_Vec W[kMD5BlockWords];
+
+    for(size_t block = 0; block < blocksCount; ++block) {
+        loadMessageWords(W, ptrs, block * kMD5DataBlockSizeBytes);
+
+        MD5_Vec a = state.a;
+        MD5_Vec b = state.b;
+        MD5_Vec c = state.c;
+        MD5_Vec d = state.d;
+
+        // round 1
+        MB_ROUND_STEP(MB_F, a, b, c, d, W[0],  0xd76aa478,  7)
+        MB_ROUND_STEP(MB_F, d, a, b, c, W[1],  0xe8c7b756, 12)
+        MB_ROUND_STEP(MB_F, c, d, a, b, W[2],  0x242070db, 17)
+        MB_ROUND_STEP(MB_F, b, c, d, a, W[3],  0xc1bdceee, 22)
+        MB_ROUND_STEP(MB_F, a, b, c, d, W[4],  0xf57c0faf,  7)
+        MB_ROUND_STEP(MB_F, d, a, b, c, W[5],  0x4787c62a, 12)
+        MB_ROUND_STEP(MB_F, c, d, a, b, W[6],  0xa8304613, 17)
+        MB_ROUND_STEP(MB_F, b, c, d, a, W[7],  0xfd469501, 22)
+        MB_ROUND_STEP(MB_F, a, b, c, d, W[8],  0x698098d8,  7)
+        MB_ROUND_STEP(MB_F, d, a, b, c, W[9],  0x8b44f7af, 12)
+        MB_ROUND_STEP(MB_F, c, d, a, b, W[10], 0xffff5bb1, 17)
+        MB_ROUND_STEP(MB_F, b, c, d, a, W[11], 0x895cd7be, 22)
+        MB_ROUND_STEP(MB_F, a, b, c, d, W[12], 0x6b901122,  7)
+        MB_ROUND_STEP(MB_F, d, a, b, c, W[13], 0xfd987193, 12)
+        MB_ROUND_STEP(MB_F, c, d, a, b, W[14], 0xa679438e, 17)
+        MB_ROUND_STEP(MB_F, b, c, d, a, W[15], 0x49b40821, 22)
+
+        // round 2
+        MB_ROUND_STEP(MB_G, a, b, c, d, W[1],  0xf61e2562,  5)
+        MB_ROUND_STEP(MB_G, d, a, b, c, W[6],  0xc040b340,  9)
+        MB_ROUND_STEP(MB_G, c, d, a, b, W[11], 0x265e5a51, 14)
+        MB_ROUND_STEP(MB_G, b, c, d, a, W[0],  0xe9b6c7aa, 20)
+        MB_ROUND_STEP(MB_G, a, b, c, d, W[5],  0xd62f105d,  5)
+        MB_ROUND_STEP(MB_G, d, a, b, c, W[10], 0x02441453,  9)
+        MB_ROUND_STEP(MB_G, c, d, a, b, W[15], 0xd8a1e681, 14)
+        MB_ROUND_STEP(MB_G, b, c, d, a, W[4],  0xe7d3fbc8, 20)
+        MB_ROUND_STEP(MB_G, a, b, c, d, W[9],  0x21e1cde6,  5)
+        MB_ROUND_STEP(MB_G, d, a, b, c, W[14], 0xc33707d6,  9)
+        MB_ROUND_STEP(MB_G, c, d, a, b, W[3],  0xf4d50d87, 14)
+        MB_ROUND_STEP(MB_G, b, c, d, a, W[8],  0x455a14ed, 20)
+        MB_ROUND_STEP(MB_G, a, b, c, d, W[13], 0xa9e3e905,  5)
+        MB_ROUND_STEP(MB_G, d, a, b, c, W[2],  0xfcefa3f8,  9)
+        MB_ROUND_STEP(MB_G, c, d, a, b, W[7],  0x676f02d9, 14)
+        MB_ROUND_STEP(MB_G, b, c, d, a, W[12], 0x8d2a4c8a, 20)
+
+        // round 3
+        MB_ROUND_STEP(MB_H, a, b, c, d, W[5],  0xfffa3942,  4)
+        MB_ROUND_STEP(MB_H, d, a, b, c, W[8],  0x8771f681, 11)
+        MB_ROUND_STEP(MB_H, c, d, a, b, W[11], 0x6d9d6122, 16)
+        MB_ROUND_STEP(MB_H, b, c, d, a, W[14], 0xfde5380c, 23)
+        MB_ROUND_STEP(MB_H, a, b, c, d, W[1],  0xa4beea44,  4)
+        MB_ROUND_STEP(MB_H, d, a, b, c, W[4],  0x4bdecfa9, 11)
+        MB_ROUND_STEP(MB_H, c, d, a, b, W[7],  0xf6bb4b60, 16)
+        MB_ROUND_STEP(MB_H, b, c, d, a, W[10], 0xbebfbc70, 23)
+        MB_ROUND_STEP(MB_H, a, b, c, d, W[13], 0x289b7ec6,  4)
+        MB_ROUND_STEP(MB_H, d, a, b, c, W[0],  0xeaa127fa, 11)
+        MB_ROUND_STEP(MB_H, c, d, a, b, W[3],  0xd4ef3085, 16)
+        MB_ROUND_STEP(MB_H, b, c, d, a, W[6],  0x04881d05, 23)
+        MB_ROUND_STEP(MB_H, a, b, c, d, W[9],  0xd9d4d039,  4)
+        MB_ROUND_STEP(MB_H, d, a, b, c, W[12], 0xe6db99e5, 11)
+        MB_ROUND_STEP(MB_H, c, d, a, b, W[15], 0x1fa27cf8, 16)
+        MB_ROUND_STEP(MB_H, b, c, d, a, W[2],  0xc4ac5665, 23)
+
+        // round 4
+        MB_ROUND_STEP(MB_I, a, b, c, d, W[0],  0xf4292244,  6)
+        MB_ROUND_STEP(MB_I, d, a, b, c, W[7],  0x432aff97, 10)
+        MB_ROUND_STEP(MB_I, c, d, a, b, W[14], 0xab9423a7, 15)
+        MB_ROUND_STEP(MB_I, b, c, d, a, W[5],  0xfc93a039, 21)
+        MB_ROUND_STEP(MB_I, a, b, c, d, W[12], 0x655b59c3,  6)
+        MB_ROUND_STEP(MB_I, d, a, b, c, W[3],  0x8f0ccc92, 10)
+        MB_ROUND_STEP(MB_I, c, d, a, b, W[10], 0xffeff47d, 15)
+        MB_ROUND_STEP(MB_I, b, c, d, a, W[1],  0x85845dd1, 21)
+        MB_ROUND_STEP(MB_I, a, b, c, d, W[8],  0x6fa87e4f,  6)
+        MB_ROUND_STEP(MB_I, d, a, b, c, W[15], 0xfe2ce6e0, 10)
+        MB_ROUND_STEP(MB_I, c, d, a, b, W[6],  0xa3014314, 15)
+        MB_ROUND_STEP(MB_I, b, c, d, a, W[13], 0x4e0811a1, 21)
+        MB_ROUND_STEP(MB_I, a, b, c, d, W[4],  0xf7537e82,  6)
+        MB_ROUND_STEP(MB_I, d, a, b, c, W[11], 0xbd3af235, 10)
+        MB_ROUND_STEP(MB_I, c, d, a, b, W[2],  0x2ad7d2bb, 15)
+        MB_ROUND_STEP(MB_I, b, c, d, a, W[9],  0xeb86d391, 21)
+
+        state.a += a;
+        state.b += b;
+        state.c += c;
+        state.d += d;
+    }
+}
+
+#undef MB_F
+#undef MB_G
+#undef MB_H
+#undef MB_I
+#undef MB_ROUND_STEP
+
+} // ns a
+
+
+void tools::hash::md5::detail::MD5_MB_KERNEL_FUNC(const unsigned char* const* data, size_t size, unsigned char* digests)
+{
+    MD5_VecState state;
+    for(size_t lane = 0; lane < MD5_MB_LANES; ++lane) {
+        state.a[lane] = 0x67452301;
+        state.b[lane] = 0xefcdab89;
+        state.c[lane] = 0x98badcfe;
+        state.d[lane] = 0x10325476;
+    }
+
+    // all full blocks directly from input
+    const size_t fullBlocksCount = size / kMD5DataBlockSizeBytes;
+    if (fullBlocksCount > 0) {
+        updateBlocks(state, data, fullBlocksCount);
+    }
+
+    // tail + padding, same layout for all lanes due equal sizes
+    const size_t tailSize = size % kMD5DataBlockSizeBytes;
+    const size_t tailBlocksCount = (tailSize < kMD5DataBlockSizeBytes - 8) ? 1 : 2;
+    const size_t tailBufferSize = tailBlocksCount * kMD5DataBlockSizeBytes;
+
+    alignas(64) unsigned char tails[MD5_MB_LANES][2 * kMD5DataBlockSizeBytes];
+    const unsigned char* tailPtrs[MD5_MB_LANES];
+
+    const uint64_t sizeBits = static_cast<uint64_t>(size) << 3;
+
+    for(size_t lane = 0; lane < MD5_MB_LANES; ++lane) {
+        unsigned char* tail = tails[lane];
+        memset(tail, 0, tailBufferSize);
+        if (tailSize > 0) {
+            memcpy(tail, data[lane] + fullBlocksCount * kMD5DataBlockSizeBytes, tailSize);
+        }
+        tail[tailSize] = 0x80;
+        storeU32LE(tail + tailBufferSize - 8, static_cast<MD5_u32>(sizeBits));
+        storeU32LE(tail + tailBufferSize - 4, static_cast<MD5_u32>(sizeBits >> 32));
+        tailPtrs[lane] = tail;
+    }
+
+    updateBlocks(state, tailPtrs, tailBlocksCount);
+
+    for(size_t lane = 0; lane < MD5_MB_LANES; ++lane) {
+        unsigned char* digest = digests + lane * kMultiBufferDigestSize;
+        storeU32LE(digest +  0, state.a[lane]);
+        storeU32LE(digest +  4, state.b[lane]);
+        storeU32LE(digest +  8, state.c[lane]);
+        storeU32LE(digest + 12, state.d[lane]);
+    }
+}
@@ -0,0 +1,5 @@
+// AVX2 multi-buffer MD5 kernel: 8 lanes. TU compiled with -mavx2, see CMakeLists.txt
+
+#define MD5_MB_LANES 8
+#define MD5_MB_KERNEL_FUNC md5MultiBufferKernelAvx2
+#include "md5_multi_kernel.inl"
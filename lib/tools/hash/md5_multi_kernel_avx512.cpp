@@ -0,0 +1,5 @@
+// AVX-512 multi-buffer MD5 kernel: 16 lanes. TU compiled with -mavx512f, see CMakeLists.txt
+
+#define MD5_MB_LANES 16
+#define MD5_MB_KERNEL_FUNC md5MultiBufferKernelAvx512
+#include "md5_multi_kernel.inl"
@@ -0,0 +1,5 @@
+// SSE2 multi-buffer MD5 kernel: 4 lanes. TU compiled with -msse2, see CMakeLists.txt
+
+#define MD5_MB_LANES 4
+#define MD5_MB_KERNEL_FUNC md5MultiBufferKernelSse2
+#include "md5_multi_kernel.inl"
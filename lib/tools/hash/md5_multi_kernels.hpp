@@ -0,0 +1,38 @@
+#ifndef LIB_TOOLS_HASH_MD5_MULTI_KERNELS_H
+#define LIB_TOOLS_HASH_MD5_MULTI_KERNELS_H
+#pragma once
+
+// private header: SIMD multi-buffer MD5 kernels, each one lives in own TU compiled with own ISA flags
+
+#include <cstddef>
+
+
+namespace tools {
+namespace hash {
+namespace md5 {
+namespace detail {
+
+
+constexpr const size_t kMultiBufferDigestSize = 16;
+
+
+/**
+ * @brief multi-buffer kernel signature
+ * @param data - exactly <lanes> pointers to buffers of same size
+ * @param size - size of each buffer in bytes
+ * @param digests - output, <lanes> * kMultiBufferDigestSize bytes
+ */
+using MultiBufferKernel = void (*)(const unsigned char* const* data, size_t size, unsigned char* digests);
+
+
+#if TOOLS_HASH_MD5_MB_X86
+void md5MultiBufferKernelSse2(const unsigned char* const* data, size_t size, unsigned char* digests);
+void md5MultiBufferKernelAvx2(const unsigned char* const* data, size_t size, unsigned char* digests);
+void md5MultiBufferKernelAvx512(const unsigned char* const* data, size_t size, unsigned char* digests);
+#endif
+
+
+}}}} // ns tools::hash::md5::detail
+
+
+#endif // LIB_TOOLS_HASH_MD5_MULTI_KERNELS_H
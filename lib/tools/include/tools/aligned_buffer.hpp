@@ -0,0 +1,63 @@
+#ifndef LIB_TOOLS_ALIGNED_BUFFER_H
+#define LIB_TOOLS_ALIGNED_BUFFER_H
+#pragma once
+
+#include <cstddef>
+
+
+namespace tools {
+
+/**
+ * @brief Owned raw memory buffer with given alignment (page/sector aligned I/O buffers etc).
+ * Content is not initialized
+ */
+class AlignedBuffer
+{
+public:
+    static constexpr const size_t kDefaultAlignment = 4096;
+
+    /**
+     * @param size - buffer size in bytes
+     * @param alignment - power of 2
+     */
+    AlignedBuffer(size_t size = 0, size_t alignment = kDefaultAlignment);
+    ~AlignedBuffer() noexcept;
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    AlignedBuffer(AlignedBuffer&& inst) noexcept;
+    AlignedBuffer& operator=(AlignedBuffer&& inst) noexcept;
+
+    /**
+     * @brief realloc buffer if it's smaller then given size. Content is not preserved
+     */
+    void reserve(size_t size);
+
+    inline char* data() noexcept {
+        return m_data;
+    }
+
+    inline const char* data() const noexcept {
+        return m_data;
+    }
+
+    inline size_t size() const noexcept {
+        return m_size;
+    }
+
+    inline size_t alignment() const noexcept {
+        return m_alignment;
+    }
+
+private:
+    char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_alignment = kDefaultAlignment;
+
+    void release() noexcept;
+};
+
+
+} // ns tools
+
+#endif // LIB_TOOLS_ALIGNED_BUFFER_H
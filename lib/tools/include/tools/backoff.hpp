@@ -0,0 +1,34 @@
+#ifndef LIB_TOOLS_BACKOFF_H
+#define LIB_TOOLS_BACKOFF_H
+#pragma once
+
+#include <cstddef>
+
+namespace tools {
+
+/**
+ * @brief Waiting strategy for lock-free polling loops: busy spins first (short waits are cheap),
+ * then yields, then sleeps (long waits like slow I/O do not burn CPU)
+ * MT: not thread-safe, one per waiting loop
+ */
+class Backoff
+{
+public:
+    /**
+     * @brief wait a bit, each next call waits longer
+     */
+    void pause();
+
+    /**
+     * @brief restart from busy spins, call on progress
+     */
+    void reset();
+
+private:
+    size_t m_step = 0;
+};
+
+
+} // ns tools
+
+#endif // LIB_TOOLS_BACKOFF_H
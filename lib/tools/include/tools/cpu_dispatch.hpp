@@ -0,0 +1,72 @@
+#ifndef LIB_TOOLS_CPU_DISPATCH_H
+#define LIB_TOOLS_CPU_DISPATCH_H
+#pragma once
+
+#include <string>
+
+/**
+ * Runtime CPU features detection (cpuid) to dispatch compiled kernel variants.
+ * Single binary runs on any CPU of arch - kernels with extended ISA are used
+ * only if CPU and OS support them.
+ */
+
+namespace tools {
+namespace cpu {
+
+
+/// instruction sets used by kernels, ordered by preference (higher - faster)
+enum class Isa {
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    AVX512,
+};
+
+
+struct Features {
+    bool sse2 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+
+/**
+ * @brief CPU features detected on first call
+ * MT: thread-safe
+ */
+const Features& detectedFeatures();
+
+/**
+ * @brief best ISA supported by both CPU and OS
+ */
+Isa detectedIsa();
+
+/**
+ * @brief limit ISA used by dispatch (for tests, benchmarks, workarounds).
+ * Must be called before first kernels binding (usually at startup)
+ */
+void setIsaLimit(Isa isa);
+Isa isaLimit();
+
+/**
+ * @brief ISA to bind kernels for: min(detected, limit)
+ */
+Isa effectiveIsa();
+
+const char* isaName(Isa isa);
+
+/**
+ * @brief parse ISA name ("scalar", "sse2", "avx2", "avx512"), throws on unknown
+ */
+Isa parseIsa(const std::string& name);
+
+/**
+ * @brief features in human readable form. Used in logging
+ */
+std::string featuresStringRepresentation(const Features& features);
+
+
+}} // ns tools::cpu
+
+#endif // LIB_TOOLS_CPU_DISPATCH_H
@@ -27,6 +27,20 @@ public:
      */
     Digest hash(const std::string_view& buffer);
 
+    /**
+     * @brief do get hashes of several independent mem. blocks at once - single virtual call for
+     * whole range of blocks. Concrete hashers can process them in parallel (SIMD lanes etc)
+     * @param buffers - blocks to hash
+     * @param count - blocks count
+     * @param digests - output, count items
+     */
+    void hashMany(const std::string_view* buffers, size_t count, Digest* digests);
+
+    /**
+     * @brief preferable count of blocks to pass to @hashMany at once. 1 => no profit of batches
+     */
+    size_t batchSizeHint() const;
+
     /**
      * @brief iterational big data block hashing intf
      */
@@ -37,6 +51,9 @@ private:
     virtual void doInitialize() = 0;
     virtual void doProcess(const std::string_view& buffer) = 0;
     virtual Digest doFinalize() = 0;
+    virtual Digest doHash(const std::string_view& buffer);
+    virtual void doHashMany(const std::string_view* buffers, size_t count, Digest* digests);
+    virtual size_t doGetBatchSizeHint() const;
 };
 
 
@@ -49,11 +66,18 @@ public:
 
     HasherPtr create();
     size_t digestSize();
+
+    /**
+     * @brief @see AbstractHasher::batchSizeHint, usable before hashers creation
+     */
+    size_t batchSizeHint();
 private:
     virtual HasherPtr doCreate() = 0;
     virtual size_t doGetDigestSize();
+    virtual size_t doGetBatchSizeHint();
 
     size_t m_digestSize = 0;
+    size_t m_batchSizeHint = 0;
 };
 
 
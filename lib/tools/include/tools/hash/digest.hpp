@@ -2,7 +2,7 @@
 #define LIB_TOOLS_HASH_DIGEST_H
 #pragma once
 
-#include <vector>
+#include <array>
 #include <ostream>
 #include <string_view>
 
@@ -12,9 +12,13 @@ namespace tools {
 namespace hash {
 
 /**
- * @brief Generic digest holder, independet on hashing algo digest lenght
+ * @brief Generic digest holder, independet on hashing algo digest lenght (up to kMaxSize).
+ * Storage is inline fixed-capacity array - no heap allocations, trivially copyable
  */
 struct Digest {
+    /// max supported digest size in bytes: enough for MD5, SHA-1, SHA-256
+    static constexpr const size_t kMaxSize = 32;
+
     // defaults
     Digest(const Digest&) = default;
     Digest(Digest&&) = default;
@@ -26,9 +30,36 @@ struct Digest {
     Digest(const std::string_view& buffer);
     Digest& operator=(const std::string_view& buffer);
 
+    inline const Byte* data() const noexcept {
+        return binary.data();
+    }
+
+    inline Byte* data() noexcept {
+        return binary.data();
+    }
+
+    inline size_t size() const noexcept {
+        return binarySize;
+    }
+
+    /**
+     * @brief set used size, content of new bytes not defined
+     * @param size - must be <= kMaxSize
+     */
+    void resize(size_t size);
+
+    inline const Byte* begin() const noexcept {
+        return binary.data();
+    }
+
+    inline const Byte* end() const noexcept {
+        return binary.data() + binarySize;
+    }
+
 
-    // main digest storage, len - variable to support any hasher
-    std::vector<Byte> binary;
+    // main digest storage, used first binarySize bytes
+    std::array<Byte, kMaxSize> binary;
+    uint8_t binarySize = 0;
 
 
     friend std::ostream& operator<<(std::ostream &stream, const Digest& digest);
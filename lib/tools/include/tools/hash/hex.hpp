@@ -0,0 +1,41 @@
+#ifndef LIB_TOOLS_HASH_HEX_H
+#define LIB_TOOLS_HASH_HEX_H
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include <tools/hash/digest.hpp>
+
+namespace tools {
+namespace hash {
+
+
+/**
+ * @brief size of digest text line: lowercase hex and '\n'
+ */
+inline size_t hexLineSize(const Digest& digest) noexcept
+{
+    return 2 * digest.size() + 1;
+}
+
+
+/**
+ * @brief encode digests to text lines, same as operator<<(std::ostream&, const Digest&) does.
+ * 16 bytes chunks are encoded by SSE2 if available, rest - by table
+ * @param out - output buffer, enough for sum of hexLineSize of all digests
+ * @return count of written bytes
+ */
+size_t encodeHexLines(const Digest* digests, size_t count, char* out) noexcept;
+
+/**
+ * @brief decode hex text (any case) to bytes
+ * @param out - output buffer, text.size() / 2 bytes
+ * @return false if text size is odd or it has not hex chars
+ */
+bool decodeHex(std::string_view text, Byte* out) noexcept;
+
+
+}} // ns tools::hash
+
+#endif // LIB_TOOLS_HASH_HEX_H
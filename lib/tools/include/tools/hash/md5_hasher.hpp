@@ -21,10 +21,18 @@ class Hasher : public AbstractHasher {
 public:
     Hasher();
     ~Hasher();
+protected:
+    /**
+     * @param fixedBlockSizeBytes - size of blocks to use specialised path for, @see FixedSizeHasher
+     */
+    explicit Hasher(size_t fixedBlockSizeBytes);
 private:
     void doInitialize() override;
     void doProcess(const std::string_view& buffer) override;
     Digest doFinalize() override;
+    Digest doHash(const std::string_view& buffer) override;
+    void doHashMany(const std::string_view* buffers, size_t count, Digest* digests) override;
+    size_t doGetBatchSizeHint() const override;
 
     std::unique_ptr<detail::HasherPrivate> d_ptr;
 };
@@ -36,6 +44,49 @@ private:
 };
 
 
+/**
+ * @return true if there is compile-time specialised path for blocks of given size
+ */
+constexpr bool isFixedBlockSizeSpecialised(size_t blockSizeBytes)
+{
+    return blockSizeBytes == 512
+        || blockSizeBytes == 4 * 1024
+        || blockSizeBytes == 64 * 1024
+        || blockSizeBytes == 1024 * 1024;
+}
+
+
+/**
+ * @brief MD5 hasher specialised for blocks of fixed size known at compile time:
+ * whole 64-byte rounds run directly from input, padding block is precomputed (constexpr).
+ * Blocks of other sizes are hashed by generic path
+ */
+template<size_t BlockSizeBytes>
+class FixedSizeHasher : public Hasher {
+    static_assert(isFixedBlockSizeSpecialised(BlockSizeBytes), "no specialisation for this block size");
+public:
+    FixedSizeHasher()
+        : Hasher(BlockSizeBytes)
+    {}
+};
+
+
+template<size_t BlockSizeBytes>
+class FixedSizeHasherFactory : public DefaultHasherFactoryImpl<FixedSizeHasher<BlockSizeBytes>> {
+private:
+    size_t doGetDigestSize() override
+    {
+        return HasherFactory().digestSize();
+    }
+};
+
+
+/**
+ * @brief choose best MD5 hasher factory for blocks of given size (specialised if any)
+ */
+HasherFactoryPtr createHasherFactory(size_t blockSizeBytes);
+
+
 }}} // ns tools::hash
 
 
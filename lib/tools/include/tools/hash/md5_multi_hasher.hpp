@@ -0,0 +1,63 @@
+#ifndef LIB_TOOLS_HASH_MD5_MULTI_HASHER_H
+#define LIB_TOOLS_HASH_MD5_MULTI_HASHER_H
+#pragma once
+
+#include <tools/hash/digest.hpp>
+
+#include <string_view>
+#include <memory>
+
+
+namespace tools {
+namespace hash {
+namespace md5 {
+
+
+namespace detail {
+struct MultiBufferHasherPrivate;
+} // ns detail
+
+
+/**
+ * @brief SIMD multi-buffer MD5 engine: hashes several independent equal sized buffers in lockstep,
+ * one buffer per SIMD lane (SSE2 - 4 lanes, AVX2 - 8 lanes, AVX-512 - 16 lanes).
+ * Kernel is bound on construction by runtime CPU dispatch @see tools/cpu_dispatch.hpp
+ * If no SIMD kernel available for CPU - lanes() == 1 and engine must not be used
+ * MT: thread-safe (stateless)
+ */
+class MultiBufferHasher {
+public:
+    MultiBufferHasher();
+    ~MultiBufferHasher();
+
+    MultiBufferHasher(const MultiBufferHasher&) = delete;
+    MultiBufferHasher(MultiBufferHasher&&) = delete;
+    MultiBufferHasher& operator=(const MultiBufferHasher&) = delete;
+    MultiBufferHasher& operator=(MultiBufferHasher&&) = delete;
+
+    /**
+     * @brief count of buffers hashed at once, 1 => no SIMD kernel available
+     */
+    size_t lanes() const;
+
+    /**
+     * @brief short name of used kernel. Used in debug logging
+     */
+    const char* kernelName() const;
+
+    /**
+     * @brief do hash buffers, if count not multiple of lanes() - last lanes are wasted
+     * @param buffers - buffers to hash, all must have same size
+     * @param count - count of buffers
+     * @param digests - output digests, count items
+     */
+    void hash(const std::string_view* buffers, size_t count, Digest* digests) const;
+private:
+    std::unique_ptr<detail::MultiBufferHasherPrivate> d_ptr;
+};
+
+
+}}} // ns tools::hash::md5
+
+
+#endif // LIB_TOOLS_HASH_MD5_MULTI_HASHER_H
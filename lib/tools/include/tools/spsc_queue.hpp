@@ -0,0 +1,97 @@
+#ifndef LIB_TOOLS_SPSC_QUEUE_H
+#define LIB_TOOLS_SPSC_QUEUE_H
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace tools {
+
+/// to keep producer and consumer counters in different cache lines
+static constexpr const size_t kCacheLineSize = 64;
+
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue (ring buffer)
+ * MT: tryPush - producer thread only, tryPop - consumer thread only
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @param capacity - max items count, rounded up to power of 2
+     */
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_items.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue(SpscQueue&&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    /**
+     * @return false if queue is full, item is not moved then
+     */
+    bool tryPush(T& item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+        m_items[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @return false if queue is empty
+     */
+    bool tryPop(T& item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+        item = std::move(m_items[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+private:
+    std::vector<T> m_items;
+    size_t m_mask = 0;
+
+    // consumer side
+    alignas(kCacheLineSize) std::atomic_size_t m_head = 0;
+    size_t m_cachedTail = 0;
+
+    // producer side
+    alignas(kCacheLineSize) std::atomic_size_t m_tail = 0;
+    size_t m_cachedHead = 0;
+};
+
+
+} // ns tools
+
+#endif // LIB_TOOLS_SPSC_QUEUE_H
@@ -58,6 +58,15 @@ public:
      * @brief num of used threads
      */
     size_t size() const;
+
+    static constexpr const size_t kNotWorkerIndex = static_cast<size_t>(-1);
+
+    /**
+     * @brief zero based index of pool worker running current thread, [0, size()).
+     * Allows jobs to use per-worker contexts without any locking
+     * @return kNotWorkerIndex if called not from pool worker
+     */
+    static size_t currentWorkerIndex();
 private:
     std::unique_ptr<detail::ThreadPoolPrivate> d_ptr;
 };
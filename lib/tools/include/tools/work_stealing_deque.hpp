@@ -0,0 +1,161 @@
+#ifndef LIB_TOOLS_WORK_STEALING_DEQUE_H
+#define LIB_TOOLS_WORK_STEALING_DEQUE_H
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <tools/spsc_queue.hpp>
+
+namespace tools {
+
+
+/**
+ * @brief Unbounded lock-free Chase-Lev work-stealing deque (Le, Pop, Cohen, Nardelli 2013 - C11 memory model version).
+ * Owner pushes and pops at bottom (LIFO), thieves steal from top (FIFO). Grown arrays are kept till destruction,
+ * so thieves may still read from them
+ * MT: push, pop - owner thread only, steal, isEmpty - any thread
+ * @tparam T - trivially copyable item, usually pointer
+ */
+template<typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable<T>::value, "item must be trivially copyable");
+public:
+    /**
+     * @param capacity - initial capacity, rounded up to power of 2
+     */
+    explicit WorkStealingDeque(size_t capacity = 256)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_arrays.push_back(std::make_unique<Array>(size));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    void push(T item)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        Array* array = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(array->mask)) {
+            array = grow(array, top, bottom);
+        }
+
+        // release => thieves see item (acquire of bottom in steal)
+        array->put(bottom, item);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * @return false if empty or last item is stolen concurrently
+     */
+    bool pop(T& item)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = array->get(bottom);
+        if (top < bottom) {
+            return true;
+        }
+
+        // last item => race with thieves
+        const bool isWon = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return isWon;
+    }
+
+    /**
+     * @return false if empty or lost race with other thief/owner (retry may succeed)
+     */
+    bool steal(T& item)
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        Array* array = m_array.load(std::memory_order_acquire);
+        item = array->get(top);
+        return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool isEmpty() const
+    {
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        return top >= bottom;
+    }
+
+private:
+    struct Array {
+        const size_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit Array(size_t size)
+            : mask(size - 1)
+            , items(new std::atomic<T>[size])
+        {
+        }
+
+        T get(int64_t index) const
+        {
+            return items[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item)
+        {
+            items[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(kCacheLineSize) std::atomic<int64_t> m_top = 0;
+    alignas(kCacheLineSize) std::atomic<int64_t> m_bottom = 0;
+    alignas(kCacheLineSize) std::atomic<Array*> m_array = nullptr;
+
+    /// all arrays ever used, owner only
+    std::vector<std::unique_ptr<Array>> m_arrays;
+
+    Array* grow(Array* array, int64_t top, int64_t bottom)
+    {
+        auto grown = std::make_unique<Array>(2 * (array->mask + 1));
+        for(int64_t i = top; i < bottom; ++i) {
+            grown->put(i, array->get(i));
+        }
+        m_arrays.push_back(std::move(grown));
+
+        Array* res = m_arrays.back().get();
+        m_array.store(res, std::memory_order_release);
+        return res;
+    }
+};
+
+
+} // ns tools
+
+#endif // LIB_TOOLS_WORK_STEALING_DEQUE_H
@@ -0,0 +1,65 @@
+#ifndef LIB_TOOLS_WORK_STEALING_THREAD_POOL_H
+#define LIB_TOOLS_WORK_STEALING_THREAD_POOL_H
+#pragma once
+
+#include <memory>
+
+#include <tools/thread_pool.hpp>
+
+namespace tools {
+
+namespace detail {
+class WorkStealingThreadPoolPrivate;
+} // ns detail
+
+
+/**
+ * @brief Threads pool with per-worker lock-free work-stealing deques (@see WorkStealingDeque).
+ * Jobs added by pool worker go to own deque (LIFO, cache-hot), jobs added by other threads go to
+ * shared injection deque (FIFO). Idle worker steals from random deques, spins a bit, then parks.
+ * Jobs are the same as for ThreadPool, but owned by pool (no shared state allocation).
+ * ThreadPool::currentWorkerIndex() works for this pool workers too
+ */
+class WorkStealingThreadPool {
+public:
+    using IJob = ThreadPool::IJob;
+    using JobUPtr = std::unique_ptr<IJob>;
+
+    /**
+     * @param nThreads - hint for threads count. If = 0 -> autochoose
+     */
+    WorkStealingThreadPool(size_t nThreads = 0);
+    ~WorkStealingThreadPool() noexcept;
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool(WorkStealingThreadPool&&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(WorkStealingThreadPool&&) = delete;
+
+    /**
+     * @brief start threads pool. If already started - will restart
+     */
+    void start();
+    /**
+     * @brief enqueue job, pool owns it. No priorities supported
+     */
+    void addJob(JobUPtr&& job);
+    /**
+     * @brief stop threads pool. Not started jobs are dropped
+     */
+    void stop();
+
+    /**
+     * @brief num of used threads
+     */
+    size_t size() const;
+
+private:
+    std::unique_ptr<detail::WorkStealingThreadPoolPrivate> d_ptr;
+};
+
+
+} // ns tools
+
+
+#endif // LIB_TOOLS_WORK_STEALING_THREAD_POOL_H
@@ -18,6 +18,8 @@ namespace tools {
 
 namespace detail {
 
+thread_local size_t currentWorkerIndex = ThreadPool::kNotWorkerIndex;
+
 struct ThreadContext {
     std::thread thread;
 };
@@ -48,8 +50,10 @@ public:
         assert(poolSize > 0 && "pool size must be > 0");
     }
 
-    void worker()
+    void worker(size_t workerIndex)
     {
+        currentWorkerIndex = workerIndex;
+
         while(runs) {
             ThreadPool::JobPtr job;
             {
@@ -97,8 +101,8 @@ public:
         runs = true;
         for(size_t i = 0; i < poolSize; ++i) {
             ThreadContextPtr tctx = std::make_shared<tools::detail::ThreadContext>();
-            tctx->thread = std::thread([this]() {
-                worker();
+            tctx->thread = std::thread([this, i]() {
+                worker(i);
             });
             pool.push_back(tctx);
         }
@@ -182,3 +186,9 @@ size_t tools::ThreadPool::size() const
 
 
 
+
+
+size_t tools::ThreadPool::currentWorkerIndex()
+{
+    return detail::currentWorkerIndex;
+}
@@ -0,0 +1,279 @@
+#include <tools/work_stealing_thread_pool.hpp>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+#include <vector>
+#include <cassert>
+
+#include <tools/backoff.hpp>
+#include <tools/work_stealing_deque.hpp>
+#include <tools/log.hpp>
+
+
+TS_LOGGER("thread_pool.ws")
+
+
+namespace tools {
+
+namespace detail {
+
+/// @see thread_pool.cpp
+extern thread_local size_t currentWorkerIndex;
+
+class WorkStealingThreadPoolPrivate;
+
+/// pool of current worker thread - worker index is valid for own pool only
+thread_local const WorkStealingThreadPoolPrivate* currentWorkStealingPool = nullptr;
+
+
+namespace {
+
+/// idle worker: rounds of steal attempts (backoff spins, then yields) before park
+constexpr const size_t kIdleSpinRounds = 128;
+
+constexpr const size_t kInitialDequeCapacity = 256;
+
+} // ns anonymous
+
+
+class WorkStealingThreadPoolPrivate {
+public:
+    using Deque = WorkStealingDeque<ThreadPool::IJob*>;
+
+    WorkStealingThreadPool* q_ptr = nullptr;
+    size_t poolSize;
+    std::vector<std::thread> pool;
+
+    /// [0, poolSize) - workers own deques, [poolSize] - injection deque for jobs from other threads
+    std::vector<std::unique_ptr<Deque>> deques;
+    std::mutex mutInjection;
+
+    std::atomic_bool runs = false;
+
+    // parking of idle workers
+    std::mutex mutPark;
+    std::condition_variable cvPark;
+    std::atomic_size_t parkedCount = 0;
+    size_t idleSpinRounds = kIdleSpinRounds;
+
+    WorkStealingThreadPoolPrivate(WorkStealingThreadPool* q_ptr, size_t nThreadsHint)
+        : q_ptr(q_ptr)
+        , poolSize(nThreadsHint)
+    {
+        if (poolSize == 0) {
+            poolSize = std::thread::hardware_concurrency();
+            if (poolSize == 0) {
+                poolSize = 1;
+            }
+        }
+        assert(poolSize > 0 && "pool size must be > 0");
+
+        // single CPU: spinning only delays threads which produce jobs
+        if (std::thread::hardware_concurrency() <= 1) {
+            idleSpinRounds = 0;
+        }
+
+        for(size_t i = 0; i <= poolSize; ++i) {
+            deques.push_back(std::make_unique<Deque>(kInitialDequeCapacity));
+        }
+    }
+
+    ~WorkStealingThreadPoolPrivate()
+    {
+        dropNotStartedJobs();
+    }
+
+    bool isOwnWorker() const
+    {
+        return currentWorkStealingPool == this && currentWorkerIndex < poolSize;
+    }
+
+    bool hasAnyJob() const
+    {
+        for(const auto& deque : deques) {
+            if (!deque->isEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findJob(size_t workerIndex, std::minstd_rand& random, ThreadPool::IJob*& job)
+    {
+        if (deques[workerIndex]->pop(job)) {
+            return true;
+        }
+
+        // random victims order => thieves do not crowd on same deque
+        const size_t dequesCount = deques.size();
+        const size_t firstVictim = random() % dequesCount;
+        for(size_t i = 0; i < dequesCount; ++i) {
+            const size_t victim = (firstVictim + i) % dequesCount;
+            if (victim != workerIndex && deques[victim]->steal(job)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void park()
+    {
+        std::unique_lock<std::mutex> guard(mutPark);
+        parkedCount.fetch_add(1);
+        // pairs with fence in wakeUpParked: either producer sees parked worker or worker sees new job
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (runs && !hasAnyJob()) {
+            cvPark.wait(guard);
+        }
+        parkedCount.fetch_sub(1);
+    }
+
+    void wakeUpParked()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parkedCount.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> guard(mutPark);
+            cvPark.notify_one();
+        }
+    }
+
+    void runJob(ThreadPool::IJob* rawJob)
+    {
+        const std::unique_ptr<ThreadPool::IJob> job(rawJob);
+        try {
+            job->run();
+        } catch(const std::exception& e) {
+            TS_ELOGF("job falied: %s", e.what());
+            std::abort();
+        } catch(...) {
+            TS_ELOG("job falied");
+            std::abort();
+        }
+    }
+
+    void worker(size_t workerIndex)
+    {
+        currentWorkerIndex = workerIndex;
+        currentWorkStealingPool = this;
+
+        std::minstd_rand random(static_cast<std::minstd_rand::result_type>(workerIndex + 1));
+        Backoff backoff;
+        size_t idleRounds = 0;
+
+        while (runs) {
+            ThreadPool::IJob* job = nullptr;
+            if (findJob(workerIndex, random, job)) {
+                runJob(job);
+                idleRounds = 0;
+                backoff.reset();
+                continue;
+            }
+
+            if (++idleRounds < idleSpinRounds) {
+                backoff.pause();
+                continue;
+            }
+
+            park();
+            idleRounds = 0;
+            backoff.reset();
+        }
+    }
+
+    void start()
+    {
+        stop();
+
+        runs = true;
+        for(size_t i = 0; i < poolSize; ++i) {
+            pool.emplace_back([this, i]() {
+                worker(i);
+            });
+        }
+    }
+
+    void addJob(ThreadPool::IJob* job)
+    {
+        if (isOwnWorker()) {
+            deques[currentWorkerIndex]->push(job);
+        } else {
+            std::lock_guard<std::mutex> guard(mutInjection);
+            deques[poolSize]->push(job);
+        }
+        wakeUpParked();
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutPark);
+            runs = false;
+            cvPark.notify_all();
+        }
+
+        for(auto& thread : pool) {
+            thread.join();
+        }
+        pool.clear();
+
+        dropNotStartedJobs();
+    }
+
+    /// MT: no workers must run
+    void dropNotStartedJobs()
+    {
+        for(auto& deque : deques) {
+            ThreadPool::IJob* job = nullptr;
+            while (deque->pop(job)) {
+                delete job;
+            }
+        }
+    }
+};
+
+}
+
+
+} // ns tools::detail
+
+
+tools::WorkStealingThreadPool::~WorkStealingThreadPool() noexcept
+{
+    try {
+        stop();
+    } catch (...) {
+    }
+}
+
+
+tools::WorkStealingThreadPool::WorkStealingThreadPool(size_t nThreads)
+    : d_ptr(new detail::WorkStealingThreadPoolPrivate(this, nThreads))
+{
+}
+
+
+void tools::WorkStealingThreadPool::start()
+{
+    d_ptr->start();
+}
+
+
+void tools::WorkStealingThreadPool::addJob(JobUPtr&& job)
+{
+    d_ptr->addJob(job.release());
+}
+
+
+void tools::WorkStealingThreadPool::stop()
+{
+    d_ptr->stop();
+}
+
+
+size_t tools::WorkStealingThreadPool::size() const
+{
+    return d_ptr->poolSize;
+}
@@ -24,10 +24,44 @@ static constexpr const SizeBytes kMaxBlockSizeBytes = 10 * kMegaBytes;
 static constexpr const SizeBytes kDefaultBlockSize = 1 * kMegaBytes;
 
 static constexpr const SizeBytes kMaxFileSizeBytes = 128 * kGigaBytes;
-static constexpr const SizeBytes kMemoryConsumptionLimit = 1 * kGigaBytes;
+/// memory budget of big buffers if not limited by user or container @see MemoryBudget
+static constexpr const SizeBytes kDefaultMemoryLimit = 1 * kGigaBytes;
+/// memory budget must hold at least this count of max(block, 1 MB) units: buffers sizing shrinks ranges down to block
+static constexpr const SizeBytes kMinMemoryLimitUnitsCount = 4;
+/// read buffer of single reader is limited by this part of memory budget
+static constexpr const SizeBytes kMaxReadBufferMemoryLimitShare = 16;
+/// buffered text writer: output buffer size, but not more then same part of memory budget as read buffer
+static constexpr const SizeBytes kTextWriterBufferSizeBytes = 1 * kMegaBytes;
+/// malloc bookkeeping + alignment per heap allocation, used in memory estimations
+static constexpr const SizeBytes kHeapBlockOverheadBytes = 16;
 
 static constexpr const SizeBytes kDefaultSingleThreadSequentalRangeSize = 1 * ss::kMegaBytes;
 
+/// auto mode: files starting from this size are read by direct I/O to not wipe out OS page cache
+static constexpr const SizeBytes kDirectIoMinFileSizeBytes = 4 * ss::kGigaBytes;
+
+/// io_uring reader: default count of reads in flight (NVMe likes 32..128)
+static constexpr const size_t kDefaultUringQueueDepth = 32;
+
+/// threaded strategy: default count of ranges to hint OS to read ahead of scheduled ones
+static constexpr const size_t kDefaultPrefetchRangesAhead = 4;
+
+/// single stream (rotational disks) mode: size of single sequental read, fanned out to hashers
+static constexpr const SizeBytes kSingleStreamReadSizeBytes = 32 * ss::kMegaBytes;
+
+/// auto mode: files starting from this size are processed with online tuning of threads count and job range size
+static constexpr const SizeBytes kAdaptiveMinFileSizeBytes = 1 * ss::kGigaBytes;
+
+/// adaptive threaded mode: upper bounds of tuned setup, as factors of initial one
+static constexpr const size_t kAdaptiveMaxThreadsFactor = 2;
+static constexpr const size_t kAdaptiveMaxRangeSizeFactor = 8;
+
+/// forced strategy spec: upper bound of threads count (hashers, readers, overlapped reads depth)
+static constexpr const size_t kMaxStrategyThreadsCount = 1024;
+
+/// limit of buffer to read several blocks at once to hash them in batch (SIMD multi-buffer hashers)
+static constexpr const SizeBytes kMaxHashBatchSizeBytes = 16 * ss::kMegaBytes;
+
 // perf test consts
 
 static constexpr const double kPerfTestMinRunTime_s = 10.0;
@@ -8,20 +8,42 @@
 #include "consts.hpp"
 #include "misc.hpp"
 #include "reader.hpp"
+#include "readers/zero_copy_reader.hpp"
+#include "readers/positional_reader.hpp"
+#include "readers/direct_reader.hpp"
+#include "profiles/device_probe.hpp"
+#include "profiles/device_profiles.hpp"
 #include "writers/stream_writer.hpp"
 #include "writers/file_stream_writer.hpp"
+#include "writers/binary_writer.hpp"
+#include "writers/buffered_text_writer.hpp"
+#include "writers/positional_writer.hpp"
+#include "writers/verify_writer.hpp"
 #include "strategies/abstract_strategy.hpp"
 
 #include <tools/hash/md5_hasher.hpp>
+#include <tools/hash/md5_multi_hasher.hpp>
+#include <tools/cpu_dispatch.hpp>
 #include <tools/log.hpp>
 #include <tools/timer.hpp>
 
 #include <limits>
+#include <algorithm>
 
 TS_LOGGER("main")
 
 
-void evaluateFileSignature(const misc::Options& opts);
+bool evaluateFileSignature(const misc::Options& opts);
+void calibrateFileDevice(const misc::Options& opts);
+void reportHashKernel(bool forced);
+void reportMemoryUsage(const ss::MemoryBudget& budget, bool forced);
+bool reportVerification(const ss::VerifyingDigestWriter& verifier, const ss::ReferenceSignature& reference,
+        const ss::FileSlicesScheme& slices, const misc::Options& options);
+void writeMismatchedBlocks(const std::vector<size_t>& mismatchedBlocks, size_t outOfRangeFirstBlock, size_t outOfRangeEndBlock,
+        const misc::Options& options);
+ss::DigestWriterPtr createWriter(const misc::Options& options, const ss::FileSlicesScheme& slices, size_t digestSize,
+        const ss::MemoryBudgetPtr& memoryBudget);
+ss::FileBlockReaderFactoryPtr createReaderFactory(ss::ReaderType readerType, const std::string& inputFilePath, const ss::FileSlicesScheme& slices);
 void performanceTest(
         const ss::HashStrategyPtr& strategy,
         const misc::Options& opts,
@@ -42,8 +64,16 @@ int main(int argc, const char* argv[])
 
     tools::log::setGlobalLogLevel(options.logLevel);
 
+    // NOTE: must be set before any hasher creation - kernels are bound once
+    tools::cpu::setIsaLimit(options.hashKernelIsaLimit);
+    reportHashKernel(options.printHashKernel);
+
     try {
-        evaluateFileSignature(options);
+        if (options.calibrate) {
+            calibrateFileDevice(options);
+        } else if (!evaluateFileSignature(options)) {
+            return 3;
+        }
     } catch (const std::exception& e) {
         TS_ELOG(e.what());
         return 2;
@@ -56,7 +86,7 @@ int main(int argc, const char* argv[])
 }
 
 
-void evaluateFileSignature(const misc::Options& options)
+bool evaluateFileSignature(const misc::Options& options)
 {
     const bool isNormalModeRun = !options.performanceTest;
 
@@ -67,33 +97,94 @@ void evaluateFileSignature(const misc::Options& options)
     }
 
     ss::AbstractHashStrategy::Configuration config;
-
-    if (isNormalModeRun) {
-        if (options.outputFilePath.empty()) {
-            config.writer = std::make_shared<ss::StreamDigestWriter>(&std::cout);
-        } else {
-            config.writer = std::make_shared<ss::FileStreamDigestWriter>(options.outputFilePath);
+    config.memoryBudget = std::make_shared<ss::MemoryBudget>(options.memoryLimitBytes);
+    TS_VLOGF("memory limit: %lld", options.memoryLimitBytes);
+
+    // verify mode: block size of binary signature overrides given one
+    ss::ReferenceSignaturePtr reference;
+    ss::SizeBytes blockSizeBytes = options.blockSizeBytes;
+    if (!options.verifySignaturePath.empty()) {
+        reference = std::make_shared<const ss::ReferenceSignature>(ss::ReferenceSignature::load(options.verifySignaturePath));
+        if (reference->blockSizeBytes() > 0) {
+            blockSizeBytes = reference->blockSizeBytes();
         }
+        if (blockSizeBytes < ss::kMinBlockSizeBytes || blockSizeBytes > ss::kMaxBlockSizeBytes) {
+            throw std::runtime_error("signature block size is out of range: " + std::to_string(blockSizeBytes));
+        }
+        TS_VLOGF("verify: signature blocks: %d, block size: %lld", reference->blockCount(), blockSizeBytes);
     }
 
     config.fileSlicesScheme = ss::FileSlicesScheme(
                 std::filesystem::file_size(inputFilePath),
-                options.blockSizeBytes,
+                blockSizeBytes,
                 options.suggestedReadBufferSize);
 
+    if (reference && reference->blockCount() != config.fileSlicesScheme.blockCount) {
+        TS_ELOGF("verify: blocks count differs: file: %d, signature: %d",
+                 config.fileSlicesScheme.blockCount, reference->blockCount());
+        if (options.failFast) {
+            // blocks of file or signature out of other one are mismatched
+            writeMismatchedBlocks({},
+                                  std::min(config.fileSlicesScheme.blockCount, reference->blockCount()),
+                                  std::max(config.fileSlicesScheme.blockCount, reference->blockCount()),
+                                  options);
+            return false;
+        }
+    }
+
+    // calibrated device => no probing, start with tuned setup
+    ss::DeviceProfile deviceProfile;
+    const bool hasDeviceProfile = !options.profileCachePath.empty()
+            && ss::DeviceProfileCache(options.profileCachePath).find(
+                misc::guessFileDeviceIdentity(options.inputFilePath), deviceProfile);
+
+    ss::ReaderType readerType = options.readerType;
     auto strategy = ss::AbstractHashStrategy::chooseStrategy(options.inputFilePath,
                                                      config.fileSlicesScheme,
-                                                     options.forcedStrategySymbol);
+                                                     options.forcedStrategy,
+                                                     readerType,
+                                                     hasDeviceProfile ? &deviceProfile : nullptr);
+
+    // read buffers of all readers must fit memory budget
+    config.fileSlicesScheme.suggestedReadBufferSizeBytes = std::min(
+                config.fileSlicesScheme.suggestedReadBufferSizeBytes,
+                options.memoryLimitBytes / ss::kMaxReadBufferMemoryLimitShare);
 
     assert(strategy.get() != nullptr && "strategy not choosed!");
 
-    config.hasherFactory = std::make_shared<tools::hash::md5::HasherFactory>();
-    config.readerfactory = std::make_shared<ss::FileBlockReaderFactoryDelegate>([options, config]() {
-        return std::make_shared<ss::FileBlockReader>(
-                    options.inputFilePath,
-                    config.fileSlicesScheme,
-                    config.fileSlicesScheme.suggestedReadBufferSizeBytes);
-    });
+    config.hasherFactory = tools::hash::md5::createHasherFactory(config.fileSlicesScheme.blockSizeBytes);
+    std::shared_ptr<ss::VerifyingDigestWriter> verifier;
+    if (isNormalModeRun && reference) {
+        verifier = std::make_shared<ss::VerifyingDigestWriter>(reference, config.hasherFactory->digestSize(),
+                                                               options.failFast, config.memoryBudget);
+        config.writer = verifier;
+    } else if (isNormalModeRun) {
+        config.writer = createWriter(options, config.fileSlicesScheme, config.hasherFactory->digestSize(), config.memoryBudget);
+    }
+    config.readerType = readerType;
+    config.readerfactory = createReaderFactory(readerType, options.inputFilePath, config.fileSlicesScheme);
+    config.readerfactory->setMemoryBudget(config.memoryBudget);
+
+    if (readerType == ss::ReaderType::Uring) {
+        config.asyncReads.file = std::make_shared<ss::FileDescriptor>(options.inputFilePath);
+        // NOTE: profile depth is per read stream, here is single stream of all reads
+        config.asyncReads.queueDepth = options.uringQueueDepth > 0
+                ? options.uringQueueDepth
+                : hasDeviceProfile
+                  ? std::max<size_t>(1, deviceProfile.threadsCount * deviceProfile.queueDepth)
+                  : ss::kDefaultUringQueueDepth;
+        config.asyncReads.buffersCount = options.uringBuffersCount;
+        config.asyncReads.file->adviseSequentalAccess();
+    }
+
+    // NOTE: direct reads bypass OS page cache => nothing to prefetch or drop
+    const bool usePrefetch = options.prefetchRangesAhead > 0 || options.dropBehind;
+    if (usePrefetch && readerType != ss::ReaderType::Direct) {
+        config.prefetch.file = std::make_shared<ss::FileDescriptor>(options.inputFilePath);
+        config.prefetch.rangesAhead = options.prefetchRangesAhead;
+        config.prefetch.dropBehind = options.dropBehind;
+    }
+    TS_DLOGF("strategy: %s", strategy->configurationStringRepresentation(config).c_str());
 
     if (isNormalModeRun) {
         strategy->hash(config);
@@ -104,6 +195,200 @@ void evaluateFileSignature(const misc::Options& options)
     if (config.writer) {
         config.writer->flush();
     }
+
+    reportMemoryUsage(*config.memoryBudget, options.printMemoryUsage);
+
+    return verifier
+            ? reportVerification(*verifier, *reference, config.fileSlicesScheme, options)
+            : true;
+}
+
+
+bool reportVerification(const ss::VerifyingDigestWriter& verifier, const ss::ReferenceSignature& reference,
+        const ss::FileSlicesScheme& slices, const misc::Options& options)
+{
+    // blocks of file out of signature are mismatched by verifier, signature blocks missing in file - here
+    const std::vector<size_t> mismatchedBlocks = verifier.mismatchedBlocks();
+    const size_t missingBlocksCount = reference.blockCount() > slices.blockCount
+            ? reference.blockCount() - slices.blockCount
+            : 0;
+    writeMismatchedBlocks(mismatchedBlocks, slices.blockCount, slices.blockCount + missingBlocksCount, options);
+
+    const bool isMatched = mismatchedBlocks.empty()
+            && verifier.verifiedBlocksCount() == slices.blockCount
+            && reference.blockCount() == slices.blockCount;
+    if (isMatched) {
+        TS_VLOGF("verify: OK, blocks: %d", slices.blockCount);
+    } else {
+        TS_ELOGF("verify: FAILED, mismatched blocks: %d, missing blocks: %d, verified blocks: %d of %d",
+                 mismatchedBlocks.size(), missingBlocksCount, verifier.verifiedBlocksCount(), slices.blockCount);
+    }
+    return isMatched;
+}
+
+
+void writeMismatchedBlocks(const std::vector<size_t>& mismatchedBlocks, size_t outOfRangeFirstBlock, size_t outOfRangeEndBlock,
+        const misc::Options& options)
+{
+    std::ofstream outputFile;
+    if (!options.outputFilePath.empty()) {
+        outputFile.open(options.outputFilePath, std::ios_base::trunc);
+        if (!outputFile.is_open()) {
+            throw std::runtime_error("failed to open output file: " + options.outputFilePath);
+        }
+    }
+    std::ostream& output = options.outputFilePath.empty() ? std::cout : outputFile;
+
+    for(const size_t blockIndex : mismatchedBlocks) {
+        output << blockIndex << '\n';
+    }
+    for(size_t blockIndex = outOfRangeFirstBlock; blockIndex < outOfRangeEndBlock; ++blockIndex) {
+        output << blockIndex << '\n';
+    }
+    output.flush();
+}
+
+
+void calibrateFileDevice(const misc::Options& options)
+{
+    const ss::DeviceIdentity identity = misc::guessFileDeviceIdentity(options.inputFilePath);
+
+    TS_VLOGF("calibrating device: %s (%s), it takes some seconds...", identity.id.c_str(), identity.model.c_str());
+    const ss::DeviceProfile profile = ss::DeviceProbe(options.inputFilePath, options.memoryLimitBytes).run();
+
+    std::cout << tools::Formatter()
+                 .format("device: %s, model: %s, rotational: %d; read size: %lld, threads: %d, queue depth: %d, throughput: %.1f MB/s",
+                         identity.id.c_str(),
+                         identity.model.c_str(),
+                         identity.isRotational ? 1 : 0,
+                         profile.readSizeBytes,
+                         profile.threadsCount,
+                         profile.queueDepth,
+                         profile.throughputBytesPerSecond / ss::kMegaBytes).str()
+              << std::endl;
+
+    if (options.profileCachePath.empty()) {
+        TS_WLOG("device profiles cache path is not set, profile is not stored");
+        return;
+    }
+
+    ss::DeviceProfileCache cache(options.profileCachePath);
+    cache.store(identity, profile);
+    cache.save();
+    TS_VLOGF("device profile stored: %s", cache.filePath().c_str());
+}
+
+
+ss::DigestWriterPtr createWriter(const misc::Options& options, const ss::FileSlicesScheme& slices, size_t digestSize,
+        const ss::MemoryBudgetPtr& memoryBudget)
+{
+    if (options.positionalOutput) {
+        // NOTE: text records are fixed size too => same header describes them
+        const ss::BinarySignatureHeader header(slices, ss::BinarySignatureHeader::MD5, digestSize);
+        return std::make_shared<ss::PositionalFileDigestWriter>(options.outputFilePath, options.outputFormat, header);
+    }
+
+    switch (options.outputFormat) {
+    case ss::OutputFormat::Binary: {
+        const ss::BinarySignatureHeader header(slices, ss::BinarySignatureHeader::MD5, digestSize);
+        if (options.outputFilePath.empty()) {
+            return std::make_shared<ss::BinaryStreamDigestWriter>(&std::cout, header);
+        }
+        return std::make_shared<ss::BinaryFileDigestWriter>(options.outputFilePath, header);
+    }
+    case ss::OutputFormat::Text:
+        break;
+    }
+
+#ifndef _WIN32
+    // NOTE: created before strategy sizes its buffers => output buffer is reserved in budget
+    return std::make_shared<ss::BufferedTextDigestWriter>(options.outputFilePath, memoryBudget);
+#else
+    (void)memoryBudget;
+#endif
+
+    if (options.outputFilePath.empty()) {
+        return std::make_shared<ss::StreamDigestWriter>(&std::cout);
+    }
+    return std::make_shared<ss::FileStreamDigestWriter>(options.outputFilePath);
+}
+
+
+ss::FileBlockReaderFactoryPtr createReaderFactory(ss::ReaderType readerType, const std::string& inputFilePath, const ss::FileSlicesScheme& slices)
+{
+    TS_VLOGF("reader: %s", misc::readerTypeName(readerType));
+
+    switch (readerType) {
+    case ss::ReaderType::ZeroCopy: {
+        // positional reads are stateless => all readers share single descriptor
+        const auto file = std::make_shared<ss::FileDescriptor>(inputFilePath);
+        return std::make_shared<ss::FileBlockReaderFactoryDelegate>([file, slices]() {
+            return std::make_shared<ss::ZeroCopyFileBlockReader>(
+                        file,
+                        slices,
+                        slices.suggestedReadBufferSizeBytes);
+        });
+    }
+    case ss::ReaderType::Uring:
+        // NOTE: io_uring reads are done by threaded strategy, readers are for other ones
+    case ss::ReaderType::Pread: {
+        const auto file = std::make_shared<ss::FileDescriptor>(inputFilePath);
+        return std::make_shared<ss::FileBlockReaderFactoryDelegate>([file, slices]() {
+            return std::make_shared<ss::PositionalFileBlockReader>(file, slices);
+        });
+    }
+    case ss::ReaderType::Direct: {
+        const auto file = ss::DirectFileBlockReader::openFile(inputFilePath);
+        return std::make_shared<ss::FileBlockReaderFactoryDelegate>([file, slices]() {
+            return std::make_shared<ss::DirectFileBlockReader>(file, slices);
+        });
+    }
+    case ss::ReaderType::Auto:
+    case ss::ReaderType::Stream:
+        break;
+    }
+
+    return std::make_shared<ss::FileBlockReaderFactoryDelegate>([inputFilePath, slices]() {
+        return std::make_shared<ss::FileBlockReader>(
+                    inputFilePath,
+                    slices,
+                    slices.suggestedReadBufferSizeBytes);
+    });
+}
+
+
+void reportHashKernel(bool forced)
+{
+    const tools::hash::md5::MultiBufferHasher multiBufferHasher;
+    const std::string report = tools::Formatter()
+            .format("hash kernel: md5 %s (%d lanes); cpu: %s; isa limit: %s",
+                    multiBufferHasher.kernelName(),
+                    static_cast<int>(multiBufferHasher.lanes()),
+                    tools::cpu::featuresStringRepresentation(tools::cpu::detectedFeatures()).c_str(),
+                    tools::cpu::isaName(tools::cpu::isaLimit())).str();
+
+    if (forced) {
+        std::cerr << report << std::endl;
+    } else {
+        TS_VLOG(report.c_str());
+    }
+}
+
+
+void reportMemoryUsage(const ss::MemoryBudget& budget, bool forced)
+{
+    const std::string report = tools::Formatter()
+            .format("memory: peak: %lld bytes (%.1f MB), limit: %lld bytes (%.1f MB)",
+                    budget.peak(),
+                    static_cast<double>(budget.peak()) / ss::kMegaBytes,
+                    budget.totalLimit(),
+                    static_cast<double>(budget.totalLimit()) / ss::kMegaBytes).str();
+
+    if (forced) {
+        std::cerr << report << std::endl;
+    } else {
+        TS_VLOG(report.c_str());
+    }
 }
 
 
@@ -116,7 +401,7 @@ void performanceTest(
             .format("perf: FS=[%16lld] BS=[%10d], ST=[%15s]",
                     config.fileSlicesScheme.fileSizeBytes,
                     config.fileSlicesScheme.blockSizeBytes,
-                    strategy->configurationStringRepresentation().c_str()).str();
+                    strategy->configurationStringRepresentation(config).c_str()).str();
 
     tools::Timer globalTimer(name, false);
 
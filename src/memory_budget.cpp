@@ -0,0 +1,188 @@
+#include "memory_budget.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cassert>
+
+
+ss::MemoryBudget::MemoryBudget(SizeBytes limitBytes)
+    : m_limitBytes(limitBytes)
+{
+}
+
+
+void ss::MemoryBudget::acquire(SizeBytes bytes)
+{
+    std::unique_lock<std::mutex> guard(m_mutUsed);
+    if (bytes > m_limitBytes - m_reservedBytes) {
+        throw std::runtime_error("memory limit is too low: " + std::to_string(bytes) + " bytes requested, "
+                                 + std::to_string(m_limitBytes - m_reservedBytes) + " bytes limit");
+    }
+
+    m_cvReleased.wait(guard, [this, bytes]() {
+        return m_usedBytes + bytes <= m_limitBytes;
+    });
+    hold(bytes);
+}
+
+
+bool ss::MemoryBudget::tryAcquire(SizeBytes bytes)
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    if (m_usedBytes + bytes > m_limitBytes) {
+        return false;
+    }
+    hold(bytes);
+    return true;
+}
+
+
+void ss::MemoryBudget::release(SizeBytes bytes)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutUsed);
+        assert(bytes <= m_usedBytes && "released more then acquired");
+        m_usedBytes -= bytes;
+    }
+    m_cvReleased.notify_all();
+}
+
+
+void ss::MemoryBudget::reserve(SizeBytes bytes)
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    if (m_usedBytes + bytes > m_limitBytes) {
+        throw std::runtime_error("memory limit is too low to reserve: " + std::to_string(bytes) + " bytes");
+    }
+    m_reservedBytes += bytes;
+    hold(bytes);
+}
+
+
+void ss::MemoryBudget::unreserve(SizeBytes bytes)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutUsed);
+        assert(bytes <= m_reservedBytes && "unreserved more then reserved");
+        m_reservedBytes -= bytes;
+        m_usedBytes -= bytes;
+    }
+    m_cvReleased.notify_all();
+}
+
+
+ss::SizeBytes ss::MemoryBudget::limit() const
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    return m_limitBytes - m_reservedBytes;
+}
+
+
+ss::SizeBytes ss::MemoryBudget::totalLimit() const
+{
+    return m_limitBytes;
+}
+
+
+ss::SizeBytes ss::MemoryBudget::used() const
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    return m_usedBytes;
+}
+
+
+ss::SizeBytes ss::MemoryBudget::available() const
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    return std::max<SizeBytes>(0, m_limitBytes - m_usedBytes);
+}
+
+
+ss::SizeBytes ss::MemoryBudget::peak() const
+{
+    std::lock_guard<std::mutex> guard(m_mutUsed);
+    return m_peakBytes;
+}
+
+
+void ss::MemoryBudget::hold(SizeBytes bytes)
+{
+    m_usedBytes += bytes;
+    m_peakBytes = std::max(m_peakBytes, m_usedBytes);
+}
+
+
+ss::MemoryBudget::Lease::Lease(const MemoryBudgetPtr &budget, SizeBytes bytes)
+    : m_budget(budget)
+{
+    resize(bytes);
+}
+
+
+ss::MemoryBudget::Lease::~Lease() noexcept
+{
+    release();
+}
+
+
+ss::MemoryBudget::Lease::Lease(Lease &&inst) noexcept
+    : m_budget(std::move(inst.m_budget))
+    , m_bytes(inst.m_bytes)
+{
+    inst.m_bytes = 0;
+}
+
+
+ss::MemoryBudget::Lease &ss::MemoryBudget::Lease::operator=(Lease &&inst) noexcept
+{
+    if (this != &inst) {
+        release();
+        m_budget = std::move(inst.m_budget);
+        m_bytes = inst.m_bytes;
+        inst.m_bytes = 0;
+    }
+    return *this;
+}
+
+
+void ss::MemoryBudget::Lease::resize(SizeBytes bytes)
+{
+    if (m_budget) {
+        if (bytes > m_bytes) {
+            m_budget->acquire(bytes - m_bytes);
+        } else if (bytes < m_bytes) {
+            m_budget->release(m_bytes - bytes);
+        }
+    }
+    m_bytes = bytes;
+}
+
+
+bool ss::MemoryBudget::Lease::tryResize(SizeBytes bytes)
+{
+    if (m_budget && bytes > m_bytes) {
+        if (!m_budget->tryAcquire(bytes - m_bytes)) {
+            return false;
+        }
+        m_bytes = bytes;
+        return true;
+    }
+    resize(bytes);
+    return true;
+}
+
+
+ss::SizeBytes ss::MemoryBudget::Lease::bytes() const
+{
+    return m_bytes;
+}
+
+
+void ss::MemoryBudget::Lease::release() noexcept
+{
+    if (m_budget && m_bytes > 0) {
+        m_budget->release(m_bytes);
+    }
+    m_bytes = 0;
+}
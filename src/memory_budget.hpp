@@ -0,0 +1,128 @@
+#ifndef SS_MEMORY_BUDGET_H
+#define SS_MEMORY_BUDGET_H
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include "types.hpp"
+
+
+namespace ss {
+
+
+class MemoryBudget;
+
+
+using MemoryBudgetPtr = std::shared_ptr<MemoryBudget>;
+
+
+/**
+ * @brief Process memory budget: accounts bytes held by big buffers (read buffers, block buffers,
+ * results reordering storage, writer buffers). Holders acquire bytes before allocation and release
+ * them after deallocation, acquisition waits until other holders release enough.
+ * Buffers sizing must be based on limit() to not wait forever, long-lived buffers created before sizing
+ * (output buffers) are reserved - limit() is lowered for others
+ * MT: thread-safe
+ */
+class MemoryBudget {
+public:
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget(MemoryBudget&&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(MemoryBudget&&) = delete;
+
+    /**
+     * @param limitBytes - max bytes held at once
+     */
+    explicit MemoryBudget(SizeBytes limitBytes);
+
+    /**
+     * @brief RAII holder of acquired bytes, released on destruction. Holder without budget only counts bytes
+     * MT: not thread-safe
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        explicit Lease(const MemoryBudgetPtr& budget, SizeBytes bytes = 0);
+        ~Lease() noexcept;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& inst) noexcept;
+        Lease& operator=(Lease&& inst) noexcept;
+
+        /**
+         * @brief change held bytes: growth waits for budget, shrinking releases
+         */
+        void resize(SizeBytes bytes);
+
+        /**
+         * @brief same as resize, but growth does not wait
+         * @return false if budget has no enough bytes now, held bytes are not changed
+         */
+        bool tryResize(SizeBytes bytes);
+
+        SizeBytes bytes() const;
+
+    private:
+        MemoryBudgetPtr m_budget;
+        SizeBytes m_bytes = 0;
+
+        void release() noexcept;
+    };
+
+    /**
+     * @brief wait until bytes fit into limit and hold them
+     * @throws std::runtime_error if bytes are out of limit at all
+     */
+    void acquire(SizeBytes bytes);
+
+    /**
+     * @return false if bytes do not fit now, nothing is held
+     */
+    bool tryAcquire(SizeBytes bytes);
+
+    void release(SizeBytes bytes);
+
+    /**
+     * @brief hold bytes for long-lived buffer: limit() is lowered, so sizing of other buffers counts them
+     * @throws std::runtime_error if bytes do not fit now
+     */
+    void reserve(SizeBytes bytes);
+    void unreserve(SizeBytes bytes);
+
+    /**
+     * @brief limit of not reserved buffers, buffers sizing is based on it
+     */
+    SizeBytes limit() const;
+    /**
+     * @brief limit given on creation, including reserved bytes
+     */
+    SizeBytes totalLimit() const;
+    SizeBytes used() const;
+    SizeBytes available() const;
+
+    /**
+     * @brief max of used bytes during whole life
+     */
+    SizeBytes peak() const;
+
+private:
+    const SizeBytes m_limitBytes;
+
+    mutable std::mutex m_mutUsed;
+    SizeBytes m_reservedBytes = 0;
+    std::condition_variable m_cvReleased;
+    SizeBytes m_usedBytes = 0;
+    SizeBytes m_peakBytes = 0;
+
+    void hold(SizeBytes bytes);
+};
+
+
+} // ns ss
+
+
+#endif // SS_MEMORY_BUDGET_H
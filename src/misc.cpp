@@ -2,12 +2,22 @@
 
 #include <filesystem>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <limits>
 #ifndef _WIN32
 #include <sys/wait.h>
 #endif
+#if defined(__linux__)
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#endif
 
 #include <tools/log.hpp>
 
+#include "profiles/device_profiles.hpp"
+
 
 TS_LOGGER("misc")
 
@@ -18,6 +28,261 @@ const char * kUsage =
 #include "usage.txt"
 ;
 
+#if defined(__linux__)
+
+/// max depth of block devices stacking (partition -> dm -> md -> loop -> ...) to follow
+constexpr const int kMaxDeviceResolveDepth = 8;
+
+
+ss::MediaType guessLinuxFileMediaType(const std::string& filePath, int depth);
+
+
+std::string readFirstLine(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+
+bool startsWith(const std::string& text, const char* prefix)
+{
+    return text.rfind(prefix, 0) == 0;
+}
+
+
+std::string trim(const std::string& text)
+{
+    const auto first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    const auto last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+
+/// major:minor
+std::string deviceIdText(dev_t device)
+{
+    return std::to_string(major(device)) + ":" + std::to_string(minor(device));
+}
+
+
+bool isMemoryFileSystem(const std::string& fileSystemType)
+{
+    return fileSystemType == "tmpfs"
+            || fileSystemType == "ramfs"
+            || fileSystemType == "devtmpfs"
+            || fileSystemType == "hugetlbfs";
+}
+
+
+bool isNetworkFileSystem(const std::string& fileSystemType)
+{
+    return startsWith(fileSystemType, "nfs")
+            || fileSystemType == "cifs"
+            || startsWith(fileSystemType, "smb")
+            || startsWith(fileSystemType, "fuse")
+            || fileSystemType == "ceph"
+            || fileSystemType == "9p"
+            || fileSystemType == "afs"
+            || fileSystemType == "glusterfs";
+}
+
+
+struct MountInfo {
+    std::string fileSystemType;
+    std::string source;
+};
+
+
+/**
+ * @brief find mount of device in /proc/self/mountinfo. Line format:
+ * id parent major:minor root mount_point options [optional fields] - type source super_options
+ */
+bool findMountInfo(dev_t device, MountInfo& info)
+{
+    std::ifstream mountInfoFile("/proc/self/mountinfo");
+    const std::string deviceId = deviceIdText(device);
+
+    std::string line;
+    while (std::getline(mountInfoFile, line)) {
+        std::istringstream fields(line);
+        std::string id, parent, lineDeviceId;
+        fields >> id >> parent >> lineDeviceId;
+        if (lineDeviceId != deviceId) {
+            continue;
+        }
+
+        std::string field;
+        while (fields >> field && field != "-") {
+        }
+        fields >> info.fileSystemType >> info.source;
+        return true;
+    }
+    return false;
+}
+
+
+/// worst case of stacked devices: any rotational => HDD
+ss::MediaType combineMediaTypes(ss::MediaType a, ss::MediaType b)
+{
+    for(const auto mediaType : {ss::MediaType::HDD, ss::MediaType::NetworkDrive, ss::MediaType::Unknown, ss::MediaType::SSD}) {
+        if (a == mediaType || b == mediaType) {
+            return mediaType;
+        }
+    }
+    return a;
+}
+
+
+/**
+ * @param deviceSysPath - block device dir in sysfs (/sys/dev/block/M:m or /sys/class/block/name)
+ */
+ss::MediaType guessBlockDeviceMediaType(const std::filesystem::path& deviceSysPath, int depth)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::path devicePath = fs::canonical(deviceSysPath, ec);
+    if (ec || depth <= 0) {
+        return ss::MediaType::Unknown;
+    }
+
+    // partition => whole disk
+    if (fs::exists(devicePath / "partition", ec)) {
+        devicePath = devicePath.parent_path();
+    }
+
+    const std::string name = devicePath.filename().string();
+    TS_DLOGF("media: block device: %s", name.c_str());
+
+    if (startsWith(name, "zram") || startsWith(name, "ram")) {
+        return ss::MediaType::Memory;
+    }
+
+    if (startsWith(name, "loop")) {
+        const std::string backingFilePath = readFirstLine(devicePath / "loop" / "backing_file");
+        return backingFilePath.empty()
+                ? ss::MediaType::Unknown
+                : guessLinuxFileMediaType(backingFilePath, depth - 1);
+    }
+
+    // device mapper, md raid etc => underlying devices
+    bool hasSlaves = false;
+    ss::MediaType res = ss::MediaType::Unknown;
+    for(const auto& slave : fs::directory_iterator(devicePath / "slaves", ec)) {
+        const auto slaveMediaType = guessBlockDeviceMediaType(fs::path("/sys/class/block") / slave.path().filename(), depth - 1);
+        res = hasSlaves ? combineMediaTypes(res, slaveMediaType) : slaveMediaType;
+        hasSlaves = true;
+    }
+    if (hasSlaves) {
+        return res;
+    }
+
+    const std::string rotational = readFirstLine(devicePath / "queue" / "rotational");
+    if (rotational == "1") {
+        return ss::MediaType::HDD;
+    }
+    if (rotational == "0") {
+        return ss::MediaType::SSD;
+    }
+    return ss::MediaType::Unknown;
+}
+
+
+ss::MediaType guessLinuxFileMediaType(const std::string& filePath, int depth)
+{
+    struct stat fileStat;
+    if (::stat(filePath.c_str(), &fileStat) != 0) {
+        return ss::MediaType::Unknown;
+    }
+
+    MountInfo mountInfo;
+    if (findMountInfo(fileStat.st_dev, mountInfo)) {
+        TS_DLOGF("media: %s: file system: %s, source: %s",
+                 filePath.c_str(), mountInfo.fileSystemType.c_str(), mountInfo.source.c_str());
+
+        if (isMemoryFileSystem(mountInfo.fileSystemType)) {
+            return ss::MediaType::Memory;
+        }
+        if (isNetworkFileSystem(mountInfo.fileSystemType)) {
+            return ss::MediaType::NetworkDrive;
+        }
+    }
+
+    // anonymous device (btrfs, overlay etc) => try device from mount source
+    dev_t device = fileStat.st_dev;
+    if (major(device) == 0) {
+        struct stat sourceStat;
+        const bool isBlockDeviceSource = startsWith(mountInfo.source, "/dev/")
+                && ::stat(mountInfo.source.c_str(), &sourceStat) == 0
+                && S_ISBLK(sourceStat.st_mode);
+        if (!isBlockDeviceSource) {
+            return ss::MediaType::Unknown;
+        }
+        device = sourceStat.st_rdev;
+    }
+
+    return guessBlockDeviceMediaType(std::filesystem::path("/sys/dev/block") / deviceIdText(device), depth);
+}
+
+
+/**
+ * @brief id and model part of identity: model of whole disk if file system is on disk,
+ * otherwise (dm, md, network etc) - file system type and mount source
+ */
+bool findLinuxFileDeviceIdentity(const std::string& filePath, ss::DeviceIdentity& identity)
+{
+    namespace fs = std::filesystem;
+
+    struct stat fileStat;
+    if (::stat(filePath.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    identity.id = deviceIdText(fileStat.st_dev);
+
+    std::error_code ec;
+    fs::path devicePath = fs::canonical(fs::path("/sys/dev/block") / identity.id, ec);
+    if (!ec) {
+        if (fs::exists(devicePath / "partition", ec)) {
+            devicePath = devicePath.parent_path();
+        }
+        identity.model = trim(readFirstLine(devicePath / "device" / "model"));
+    }
+
+    MountInfo mountInfo;
+    if (identity.model.empty() && findMountInfo(fileStat.st_dev, mountInfo)) {
+        identity.model = mountInfo.fileSystemType + " " + mountInfo.source;
+    }
+    return true;
+}
+
+
+/**
+ * @return 0 if not limited
+ */
+ss::SizeBytes findLinuxCgroupMemoryLimit()
+{
+    // cgroup v2 ("max" => not limited), then v1 (not limited => near max of int64)
+    for(const char* path : {"/sys/fs/cgroup/memory.max", "/sys/fs/cgroup/memory/memory.limit_in_bytes"}) {
+        const std::string text = trim(readFirstLine(path));
+        if (text.empty() || text == "max") {
+            continue;
+        }
+        try {
+            const unsigned long long limit = std::stoull(text);
+            return static_cast<ss::SizeBytes>(std::min<unsigned long long>(limit, std::numeric_limits<ss::SizeBytes>::max()));
+        } catch (const std::exception&) {
+        }
+    }
+    return 0;
+}
+
+#endif // __linux__
+
 } // ns a
 
 
@@ -63,9 +328,53 @@ ss::SizeBytes misc::parseBlockSize(const std::string &blockSizeText)
 }
 
 
+ss::ReaderType misc::parseReaderType(const std::string &readerTypeText)
+{
+    for(const auto readerType : {ss::ReaderType::Auto, ss::ReaderType::Stream, ss::ReaderType::ZeroCopy, ss::ReaderType::Pread, ss::ReaderType::Direct, ss::ReaderType::Uring}) {
+        if (readerTypeText == readerTypeName(readerType)) {
+            return readerType;
+        }
+    }
+    throw std::runtime_error("unknown reader type: " + readerTypeText);
+}
+
+
+const char *misc::readerTypeName(ss::ReaderType readerType)
+{
+    switch (readerType) {
+    case ss::ReaderType::Auto:
+        return "auto";
+    case ss::ReaderType::Stream:
+        return "stream";
+    case ss::ReaderType::ZeroCopy:
+        return "zerocopy";
+    case ss::ReaderType::Pread:
+        return "pread";
+    case ss::ReaderType::Direct:
+        return "direct";
+    case ss::ReaderType::Uring:
+        return "uring";
+    }
+    return "unknown";
+}
+
+
+ss::OutputFormat misc::parseOutputFormat(const std::string &outputFormatText)
+{
+    if (outputFormatText == "text") {
+        return ss::OutputFormat::Text;
+    }
+    if (outputFormatText == "binary") {
+        return ss::OutputFormat::Binary;
+    }
+    throw std::runtime_error("unknown output format: " + outputFormatText);
+}
+
+
 misc::Options misc::parseCliParameters(int argc, const char *argv[])
 {
     Options options;
+    options.profileCachePath = ss::DeviceProfileCache::defaultFilePath();
     if (argc < 2) {
         throw std::runtime_error("input file path not given");
     }
@@ -78,6 +387,46 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
         }
         const size_t argLength = currArg.size();
 
+        // check - is it long option: --name[=value]?
+        if (argLength > 2 && currArg[0] == '-' && currArg[1] == '-') {
+            const auto valuePos = currArg.find('=');
+            const std::string name(currArg.substr(2, valuePos == std::string_view::npos ? std::string_view::npos : valuePos - 2));
+            const std::string value(valuePos == std::string_view::npos ? std::string_view() : currArg.substr(valuePos + 1));
+
+            if (name == "kernel") {
+                options.hashKernelIsaLimit = value == "auto"
+                        ? tools::cpu::Isa::AVX512
+                        : tools::cpu::parseIsa(value);
+            } else if (name == "reader") {
+                options.readerType = misc::parseReaderType(value);
+            } else if (name == "uring-depth") {
+                options.uringQueueDepth = std::stoul(value);
+            } else if (name == "uring-buffers") {
+                options.uringBuffersCount = std::stoul(value);
+            } else if (name == "prefetch") {
+                options.prefetchRangesAhead = std::stoul(value);
+            } else if (name == "drop-behind") {
+                options.dropBehind = true;
+            } else if (name == "calibrate") {
+                options.calibrate = true;
+            } else if (name == "profile-cache") {
+                options.profileCachePath = value;
+            } else if (name == "format") {
+                options.outputFormat = misc::parseOutputFormat(value);
+            } else if (name == "positional-output") {
+                options.positionalOutput = true;
+            } else if (name == "verify") {
+                options.verifySignaturePath = value;
+            } else if (name == "fail-fast") {
+                options.failFast = true;
+            } else if (name == "memory-limit") {
+                options.memoryLimitBytes = misc::parseBlockSize(value);
+            } else {
+                throw std::runtime_error("unknown option: " + name);
+            }
+            continue;
+        }
+
         // check - is it flag?
         if (currArg[0] == '-' && argLength > 1) {
             for(size_t j = 1; j < argLength; ++j) {
@@ -88,6 +437,12 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
                     case 'p':
                         options.performanceTest = true;
                         break;
+                    case 'k':
+                        options.printHashKernel = true;
+                        break;
+                    case 'm':
+                        options.printMemoryUsage = true;
+                        break;
                 }
             }
             continue;
@@ -107,7 +462,7 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
             options.blockSizeBytes = misc::parseBlockSize(std::string(currArg));
             break;
         case 3:
-            options.forcedStrategySymbol = currArg;
+            options.forcedStrategy = ss::StrategySpec::parse(std::string(currArg));
             break;
         case 4:
             options.suggestedReadBufferSize = misc::parseBlockSize(std::string(currArg));
@@ -122,6 +477,22 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
     if (options.blockSizeBytes <= 0) {
         options.blockSizeBytes = Options::kDefaultBlockSize;
     }
+    // NOTE: only explicit limit is checked, derived one (small container, large blocks) is raised to minimal one
+    const ss::SizeBytes minMemoryLimitBytes = ss::kMinMemoryLimitUnitsCount * std::max(options.blockSizeBytes, ss::kMegaBytes);
+    const bool isMemoryLimitExplicit = options.memoryLimitBytes > 0;
+    if (!isMemoryLimitExplicit) {
+        options.memoryLimitBytes = misc::suggestMemoryLimit();
+        if (options.memoryLimitBytes < minMemoryLimitBytes) {
+            TS_WLOGF("memory limit is raised to minimal: %lld => %lld", options.memoryLimitBytes, minMemoryLimitBytes);
+            options.memoryLimitBytes = minMemoryLimitBytes;
+        }
+    }
+    const ss::StrategySpec& spec = options.forcedStrategy;
+    options.readerType = spec.io.value_or(options.readerType);
+    options.prefetchRangesAhead = spec.prefetch.value_or(options.prefetchRangesAhead);
+    options.dropBehind = spec.dropBehind.value_or(options.dropBehind);
+    options.uringQueueDepth = spec.uringDepth.value_or(options.uringQueueDepth);
+    options.uringBuffersCount = spec.uringBuffers.value_or(options.uringBuffersCount);
 
     // checks
     if (options.inputFilePath.empty()) {
@@ -133,6 +504,18 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
     if (options.blockSizeBytes > ss::kMaxBlockSizeBytes) {
         throw std::runtime_error("block size is greater then maximal");
     }
+    if (options.positionalOutput && options.outputFilePath.empty()) {
+        throw std::runtime_error("positional output requires output file");
+    }
+    if (options.positionalOutput && !options.verifySignaturePath.empty()) {
+        throw std::runtime_error("positional output is not used in verify mode");
+    }
+    if (options.failFast && options.verifySignaturePath.empty()) {
+        throw std::runtime_error("fail fast is used in verify mode only");
+    }
+    if (isMemoryLimitExplicit && options.memoryLimitBytes < minMemoryLimitBytes) {
+        throw std::runtime_error("memory limit is less then minimal: " + std::to_string(minMemoryLimitBytes));
+    }
 
     return options;
 }
@@ -140,12 +523,83 @@ misc::Options misc::parseCliParameters(int argc, const char *argv[])
 
 ss::MediaType misc::guessFileMediaType(const std::string &filePath)
 {
-    //TODO 0: implement!
-    //    cat /sys/block/sda/queue/rotational
-    //    https://stackoverflow.com/questions/2337139/where-is-a-file-mounted
-    //    win/lin diff procs
+#if defined(__linux__)
+    const ss::MediaType res = guessLinuxFileMediaType(filePath, kMaxDeviceResolveDepth);
+#else
+    //TODO 0: implement for win/mac
+    (void)filePath;
+    const ss::MediaType res = ss::MediaType::Unknown;
+#endif
+    TS_DLOGF("media: %s: %s", filePath.c_str(), mediaTypeName(res));
+    return res;
+}
 
-    return ss::MediaType::Unknown;
+
+ss::DeviceIdentity misc::guessFileDeviceIdentity(const std::string &filePath)
+{
+    ss::DeviceIdentity res;
+#if defined(__linux__)
+    findLinuxFileDeviceIdentity(filePath, res);
+#else
+    //TODO 0: implement for win/mac
+#endif
+    res.isRotational = guessFileMediaType(filePath) == ss::MediaType::HDD;
+    TS_DLOGF("device: %s: id: %s, model: %s, rotational: %d",
+             filePath.c_str(), res.id.c_str(), res.model.c_str(), res.isRotational ? 1 : 0);
+    return res;
+}
+
+
+const char *misc::mediaTypeName(ss::MediaType mediaType)
+{
+    switch (mediaType) {
+    case ss::MediaType::Unknown:
+        return "unknown";
+    case ss::MediaType::Memory:
+        return "memory";
+    case ss::MediaType::SSD:
+        return "ssd";
+    case ss::MediaType::HDD:
+        return "hdd";
+    case ss::MediaType::NetworkDrive:
+        return "network";
+    }
+    return "unknown";
+}
+
+
+size_t misc::suggestReaderThreadsCountByMediaType(ss::MediaType mediaType)
+{
+    switch (mediaType) {
+    case ss::MediaType::HDD:
+    case ss::MediaType::NetworkDrive:
+        // seeks between streams kill throughput
+        return 1;
+    case ss::MediaType::SSD:
+        // NVMe needs deep queues
+        return 4;
+    case ss::MediaType::Memory:
+    case ss::MediaType::Unknown:
+        return 2;
+    }
+    return 1;
+}
+
+
+ss::SizeBytes misc::suggestMemoryLimit()
+{
+#if defined(__linux__)
+    const ss::SizeBytes containerLimit = findLinuxCgroupMemoryLimit();
+#else
+    //TODO 0: implement for win/mac
+    const ss::SizeBytes containerLimit = 0;
+#endif
+    TS_DLOGF("memory: container limit: %lld", containerLimit);
+
+    // other half is for code, OS page cache of container etc
+    return containerLimit > 0
+            ? std::min(ss::kDefaultMemoryLimit, containerLimit / 2)
+            : ss::kDefaultMemoryLimit;
 }
 
 
@@ -164,8 +618,13 @@ void misc::dropOSCaches()
 }
 
 
-ss::SizeBytes misc::suggestReadBufferSizeByMediaType(ss::MediaType mediaType, ss::SizeBytes blockSizeBytes)
+ss::SizeBytes misc::suggestReadBufferSizeByMediaType(ss::MediaType mediaType, ss::SizeBytes blockSizeBytes,
+                                                     const ss::DeviceProfile* deviceProfile)
 {
+    if (deviceProfile != nullptr && deviceProfile->readSizeBytes > 0) {
+        return std::max(deviceProfile->readSizeBytes, blockSizeBytes);
+    }
+
     //TODO 0: tune suggested values after perf tests
     switch (mediaType) {
     case ss::MediaType::Memory:
@@ -4,8 +4,11 @@
 
 #include <string>
 
+#include <tools/cpu_dispatch.hpp>
+
 #include "types.hpp"
 #include "consts.hpp"
+#include "strategies/strategy_spec.hpp"
 
 
 namespace misc {
@@ -22,6 +25,22 @@ void printUsage(const char* appPath);
 ss::SizeBytes parseBlockSize(const std::string &blockSizeText);
 
 
+/**
+ * @brief do parse reader type name: auto | stream | zerocopy | pread | direct | uring
+ */
+ss::ReaderType parseReaderType(const std::string &readerTypeText);
+
+/**
+ * @brief reader type name, used in logging
+ */
+const char* readerTypeName(ss::ReaderType readerType);
+
+/**
+ * @brief do parse output format name: text | binary
+ */
+ss::OutputFormat parseOutputFormat(const std::string &outputFormatText);
+
+
 /**
  * @brief Application options from cli
  */
@@ -30,21 +49,66 @@ struct Options {
 
     std::string inputFilePath;
     std::string outputFilePath;
+    ss::OutputFormat outputFormat = ss::OutputFormat::Text;
+    /// preallocated output file, results are written at blocks offsets @see PositionalFileDigestWriter
+    bool positionalOutput = false;
+
+    /// verify mode: signature to compare with, empty => signature is written
+    std::string verifySignaturePath;
+    /// verify mode: stop on first mismatch
+    bool failFast = false;
     ss::SizeBytes blockSizeBytes = kDefaultBlockSize;
 
     /// 0 => autochoose
     ss::SizeBytes suggestedReadBufferSize = 0;
 
     /**
-     * @brief used for debug diff strategies
+     * @brief forced strategy, its I/O knobs override corresponding options. Used for tuning and debug diff strategies
      */
-    std::string forcedStrategySymbol;
+    ss::StrategySpec forcedStrategy;
 
     /**
      * @brief do run perf tests @see main.cpp
      */
     bool performanceTest = false;
 
+    /**
+     * @brief max instruction set for hashing kernels. Default - best one supported by CPU
+     */
+    tools::cpu::Isa hashKernelIsaLimit = tools::cpu::Isa::AVX512;
+
+    /**
+     * @brief do report choosed hashing kernel to stderr
+     */
+    bool printHashKernel = false;
+
+    ss::ReaderType readerType = ss::ReaderType::Auto;
+
+    /// io_uring reader: max reads in flight and count of range buffers (0 => autochoose)
+    size_t uringQueueDepth = 0;
+    size_t uringBuffersCount = 0;
+
+    /// count of ranges to prefetch (OS read-ahead hints) ahead of hashing, 0 => disabled
+    size_t prefetchRangesAhead = ss::kDefaultPrefetchRangesAhead;
+    /// drop hashed ranges from OS page cache
+    bool dropBehind = false;
+
+    /**
+     * @brief do calibrate device of input file and store its profile instead of hashing
+     */
+    bool calibrate = false;
+
+    /// tuned device profiles cache file, empty => not used. Default - per-user cache
+    std::string profileCachePath;
+
+    /// memory budget of buffers, 0 => autochoose @see suggestMemoryLimit
+    ss::SizeBytes memoryLimitBytes = 0;
+
+    /**
+     * @brief do report peak memory usage to stderr at exit
+     */
+    bool printMemoryUsage = false;
+
     int logLevel = 0;
 };
 
@@ -55,16 +119,41 @@ struct Options {
 Options parseCliParameters(int argc, const char* argv[]);
 
 /**
- * @brief try to guess file media from file path. NOT IMPLEMENTED,
- * @return default value
+ * @brief try to guess file media from file path. Linux: by file system type and
+ * underlying block device(s) (partitions, dm, md, loop are resolved), other OS - not implemented
+ * @return MediaType::Unknown if not detected
  */
 ss::MediaType guessFileMediaType(const std::string& filePath);
 
+/**
+ * @brief identity of device holding file (key of device profiles)
+ * Linux: major:minor of file system device, disk model and rotational flag, other OS - not implemented
+ */
+ss::DeviceIdentity guessFileDeviceIdentity(const std::string& filePath);
+
+/**
+ * @brief media type name, used in logging
+ */
+const char* mediaTypeName(ss::MediaType mediaType);
+
 /**
  * @brief try to suggest buffer size depending on media type
  * @param blockSize - hashable block size in bytes
+ * @param deviceProfile - tuned profile of device if calibrated, preferred over media type defaults
+ */
+ss::SizeBytes suggestReadBufferSizeByMediaType(ss::MediaType mediaType, ss::SizeBytes blockSizeBytes,
+                                               const ss::DeviceProfile* deviceProfile = nullptr);
+
+/**
+ * @brief try to suggest count of concurrent reading threads (I/O streams) depending on media type
+ */
+size_t suggestReaderThreadsCountByMediaType(ss::MediaType mediaType);
+
+/**
+ * @brief default memory budget: ss::kDefaultMemoryLimit, but not more then half of container limit
+ * (Linux: cgroup v2/v1 memory limit, other OS - not implemented)
  */
-ss::SizeBytes suggestReadBufferSizeByMediaType(ss::MediaType mediaType, ss::SizeBytes blockSizeBytes);
+ss::SizeBytes suggestMemoryLimit();
 
 /**
  * @brief do drop OS caches. Used in performance tests
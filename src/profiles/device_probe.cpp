@@ -0,0 +1,210 @@
+#include "device_probe.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <tools/aligned_buffer.hpp>
+#include <tools/log.hpp>
+
+#include "consts.hpp"
+#include "readers/direct_reader.hpp"
+#include "readers/io_uring.hpp"
+
+
+TS_LOGGER("profiles.probe")
+
+
+namespace {
+
+
+constexpr const ss::SizeBytes kProbeReadSizes[] = {256 * ss::kKiloBytes, 1 * ss::kMegaBytes, 4 * ss::kMegaBytes, 16 * ss::kMegaBytes};
+constexpr const size_t kProbeThreadsCounts[] = {1, 2, 4, 8};
+constexpr const size_t kProbeQueueDepths[] = {1, 4, 16};
+
+/// measure time of single grid cell
+constexpr const auto kProbeCellDuration = std::chrono::milliseconds(100);
+
+/// more expensive setup must be better by this factor to win
+constexpr const double kMinImprovement = 1.05;
+
+
+} // ns anonymous
+
+
+ss::DeviceProbe::DeviceProbe(const std::string &filePath, SizeBytes memoryLimitBytes)
+    : m_file(DirectFileBlockReader::openFile(filePath))
+    , m_memoryLimitBytes(memoryLimitBytes)
+{
+    const SizeBytes fileSizeBytes = static_cast<SizeBytes>(std::filesystem::file_size(filePath));
+    if (fileSizeBytes < kProbeReadSizes[0]) {
+        throw std::runtime_error("file is too small to calibrate device: " + filePath);
+    }
+    m_fileSizeBytes = fileSizeBytes;
+}
+
+
+ss::DeviceProfile ss::DeviceProbe::run()
+{
+    const bool isQueuedReadsSupported = IoUring::isSupported();
+
+    DeviceProfile best;
+    for(const auto readSizeBytes : kProbeReadSizes) {
+        if (readSizeBytes > m_fileSizeBytes) {
+            break;
+        }
+        for(const auto threadsCount : kProbeThreadsCounts) {
+            for(const auto queueDepth : kProbeQueueDepths) {
+                if (queueDepth > 1 && !isQueuedReadsSupported) {
+                    break;
+                }
+                // buffers of all reads in flight
+                if (readSizeBytes * static_cast<SizeBytes>(threadsCount * queueDepth) > m_memoryLimitBytes) {
+                    break;
+                }
+
+                DeviceProfile setup;
+                setup.readSizeBytes = readSizeBytes;
+                setup.threadsCount = threadsCount;
+                setup.queueDepth = queueDepth;
+                setup.throughputBytesPerSecond = measureThroughput(setup);
+
+                TS_VLOGF("probe: read size: %lld, threads: %d, queue depth: %d, throughput: %.1f MB/s",
+                         setup.readSizeBytes, setup.threadsCount, setup.queueDepth,
+                         setup.throughputBytesPerSecond / ss::kMegaBytes);
+
+                // grid goes from cheaper setups
+                if (setup.throughputBytesPerSecond > best.throughputBytesPerSecond * kMinImprovement) {
+                    best = setup;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+
+double ss::DeviceProbe::measureThroughput(const DeviceProfile &setup)
+{
+    // buffered fallback => previous cells must not be read from OS cache
+    m_file->adviseDontNeed(0, m_fileSizeBytes);
+
+    // each cell starts from other file place
+    const size_t chunksCount = static_cast<size_t>(m_fileSizeBytes / setup.readSizeBytes);
+    const size_t startChunk = m_nextStartChunk % chunksCount;
+    m_nextStartChunk = startChunk + setup.threadsCount * setup.queueDepth;
+
+    std::mutex mutResults;
+    SizeBytes totalBytes = 0;
+    std::exception_ptr readError;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + kProbeCellDuration;
+
+    std::vector<std::thread> threads;
+    threads.reserve(setup.threadsCount);
+    for(size_t i = 0; i < setup.threadsCount; ++i) {
+        threads.emplace_back([&, i]() {
+            try {
+                const SizeBytes bytes = setup.queueDepth > 1
+                        ? readStreamQueued(setup, i, startChunk, deadline)
+                        : readStream(setup, i, startChunk, deadline);
+                std::lock_guard<std::mutex> guard(mutResults);
+                totalBytes += bytes;
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(mutResults);
+                readError = std::current_exception();
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    if (readError) {
+        std::rethrow_exception(readError);
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0.0 ? totalBytes / seconds : 0.0;
+}
+
+
+ss::SizeBytes ss::DeviceProbe::readStream(const DeviceProfile &setup, size_t streamIndex, size_t startChunk,
+                                          std::chrono::steady_clock::time_point deadline) const
+{
+    const size_t chunksCount = static_cast<size_t>(m_fileSizeBytes / setup.readSizeBytes);
+    tools::AlignedBuffer buffer(setup.readSizeBytes);
+
+    SizeBytes totalBytes = 0;
+    size_t chunk = startChunk + streamIndex;
+    while (std::chrono::steady_clock::now() < deadline) {
+        totalBytes += m_file->readUpTo(buffer.data(), setup.readSizeBytes, (chunk % chunksCount) * setup.readSizeBytes);
+        chunk += setup.threadsCount;
+    }
+    return totalBytes;
+}
+
+
+ss::SizeBytes ss::DeviceProbe::readStreamQueued(const DeviceProfile &setup, size_t streamIndex, size_t startChunk,
+                                                std::chrono::steady_clock::time_point deadline) const
+{
+    const size_t chunksCount = static_cast<size_t>(m_fileSizeBytes / setup.readSizeBytes);
+
+    IoUring ring(static_cast<unsigned>(setup.queueDepth));
+    std::vector<tools::AlignedBuffer> buffers;
+    buffers.reserve(setup.queueDepth);
+
+    size_t chunk = startChunk + streamIndex;
+    const auto submitRead = [&](size_t bufferIndex) {
+        const bool queued = ring.prepareRead(m_file->fd(),
+                                             buffers[bufferIndex].data(),
+                                             static_cast<uint32_t>(setup.readSizeBytes),
+                                             (chunk % chunksCount) * setup.readSizeBytes,
+                                             bufferIndex);
+        if (!queued) {
+            throw std::runtime_error("io_uring submission queue overflow");
+        }
+        chunk += setup.threadsCount;
+    };
+
+    for(size_t i = 0; i < setup.queueDepth; ++i) {
+        buffers.emplace_back(setup.readSizeBytes);
+        submitRead(i);
+    }
+    ring.submit();
+
+    // NOTE: buffers are owned by kernel till completion => all reads in flight must be reaped, even on error
+    SizeBytes totalBytes = 0;
+    int readError = 0;
+    size_t readsInFlight = setup.queueDepth;
+    while (readsInFlight > 0) {
+        ring.submit(1);
+
+        const bool isTimeOver = std::chrono::steady_clock::now() >= deadline;
+        IoUring::Completion completion;
+        while (ring.popCompletion(completion)) {
+            --readsInFlight;
+            if (completion.result < 0 && completion.result != -EINTR && completion.result != -EAGAIN) {
+                readError = -completion.result;
+            } else if (completion.result > 0) {
+                totalBytes += completion.result;
+            }
+            if (!isTimeOver && readError == 0) {
+                submitRead(static_cast<size_t>(completion.userData));
+                ++readsInFlight;
+            }
+        }
+    }
+
+    if (readError != 0) {
+        throw std::runtime_error(std::string("probe read error: ") + std::strerror(readError));
+    }
+    return totalBytes;
+}
@@ -0,0 +1,57 @@
+#ifndef SS_PROFILES_DEVICE_PROBE_H
+#define SS_PROFILES_DEVICE_PROBE_H
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "types.hpp"
+#include "readers/file_descriptor.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Device calibration: measures read throughput of file for grid of
+ * read size x read streams count x reads in flight per stream (io_uring, if supported).
+ * Reads bypass OS cache if possible, cheapest setup wins on near equal throughput
+ * MT: not thread-safe
+ */
+class DeviceProbe {
+public:
+    /**
+     * @param filePath - any large enough file on device, at least smallest probed read size
+     * @param memoryLimitBytes - buffers of all reads in flight must fit it
+     */
+    DeviceProbe(const std::string& filePath, SizeBytes memoryLimitBytes);
+
+    /**
+     * @brief do probe all grid, takes some seconds
+     * @return best found setup
+     */
+    DeviceProfile run();
+
+private:
+    FileDescriptorPtr m_file;
+    SizeBytes m_fileSizeBytes = 0;
+    SizeBytes m_memoryLimitBytes = 0;
+    size_t m_nextStartChunk = 0;
+
+    double measureThroughput(const DeviceProfile& setup);
+
+    /**
+     * @brief read interleaved chunks (stream, stream + streams count, ...) till deadline
+     * @return bytes read
+     */
+    SizeBytes readStream(const DeviceProfile& setup, size_t streamIndex, size_t startChunk,
+                         std::chrono::steady_clock::time_point deadline) const;
+    SizeBytes readStreamQueued(const DeviceProfile& setup, size_t streamIndex, size_t startChunk,
+                               std::chrono::steady_clock::time_point deadline) const;
+};
+
+
+} // ns ss
+
+
+#endif // SS_PROFILES_DEVICE_PROBE_H
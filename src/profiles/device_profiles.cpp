@@ -0,0 +1,174 @@
+#include "device_profiles.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <tools/log.hpp>
+
+
+TS_LOGGER("profiles")
+
+
+namespace {
+
+
+/// placeholder of empty model to keep line format parsable
+constexpr const char* kEmptyModel = "-";
+
+
+bool isSameDevice(const ss::DeviceIdentity& a, const ss::DeviceIdentity& b)
+{
+    return a.id == b.id
+            && a.model == b.model
+            && a.isRotational == b.isRotational;
+}
+
+
+} // ns anonymous
+
+
+ss::DeviceProfileCache::DeviceProfileCache(const std::string &filePath)
+    : m_filePath(filePath)
+{
+    if (!m_filePath.empty()) {
+        load();
+    }
+}
+
+
+std::string ss::DeviceProfileCache::defaultFilePath()
+{
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    std::filesystem::path cacheDir;
+    if (cacheHome != nullptr && *cacheHome != '\0') {
+        cacheDir = cacheHome;
+    } else {
+        const char* home = std::getenv("HOME");
+        if (home == nullptr || *home == '\0') {
+            return std::string();
+        }
+        cacheDir = std::filesystem::path(home) / ".cache";
+    }
+    return (cacheDir / "segmented_signature" / "device_profiles").string();
+}
+
+
+const std::string &ss::DeviceProfileCache::filePath() const
+{
+    return m_filePath;
+}
+
+
+bool ss::DeviceProfileCache::find(const DeviceIdentity &identity, DeviceProfile &profile) const
+{
+    for(const auto& entry : m_entries) {
+        if (isSameDevice(entry.identity, identity)) {
+            profile = entry.profile;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void ss::DeviceProfileCache::store(const DeviceIdentity &identity, const DeviceProfile &profile)
+{
+    for(auto& entry : m_entries) {
+        if (isSameDevice(entry.identity, identity)) {
+            entry.profile = profile;
+            return;
+        }
+    }
+    m_entries.push_back(Entry{identity, profile});
+}
+
+
+void ss::DeviceProfileCache::save() const
+{
+    if (m_filePath.empty()) {
+        throw std::runtime_error("device profiles cache file path is not set");
+    }
+
+    const std::filesystem::path filePath(m_filePath);
+    if (filePath.has_parent_path()) {
+        std::filesystem::create_directories(filePath.parent_path());
+    }
+
+    const std::string tempFilePath = m_filePath + ".tmp";
+    {
+        std::ofstream file(tempFilePath, std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("failed to write device profiles cache: " + tempFilePath);
+        }
+
+        file << "# major:minor rotational read_size threads queue_depth throughput model\n";
+        for(const auto& entry : m_entries) {
+            file << entry.identity.id << ' '
+                 << (entry.identity.isRotational ? 1 : 0) << ' '
+                 << entry.profile.readSizeBytes << ' '
+                 << entry.profile.threadsCount << ' '
+                 << entry.profile.queueDepth << ' '
+                 << static_cast<long long>(entry.profile.throughputBytesPerSecond) << ' '
+                 << (entry.identity.model.empty() ? kEmptyModel : entry.identity.model) << '\n';
+        }
+
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("failed to write device profiles cache: " + tempFilePath);
+        }
+    }
+
+    std::filesystem::rename(tempFilePath, filePath);
+}
+
+
+void ss::DeviceProfileCache::load()
+{
+    std::ifstream file(m_filePath);
+    if (!file) {
+        TS_DLOGF("no device profiles cache: %s", m_filePath.c_str());
+        return;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        Entry entry;
+        int isRotational = 0;
+        long long throughput = 0;
+        fields >> entry.identity.id
+               >> isRotational
+               >> entry.profile.readSizeBytes
+               >> entry.profile.threadsCount
+               >> entry.profile.queueDepth
+               >> throughput;
+
+        const bool isValid = fields
+                && entry.profile.readSizeBytes > 0
+                && entry.profile.threadsCount > 0
+                && entry.profile.queueDepth > 0;
+        if (!isValid) {
+            TS_WLOGF("broken device profile skipped: %s", line.c_str());
+            continue;
+        }
+
+        // model is the rest of line, may contain spaces
+        std::getline(fields >> std::ws, entry.identity.model);
+        if (entry.identity.model == kEmptyModel) {
+            entry.identity.model.clear();
+        }
+        entry.identity.isRotational = isRotational != 0;
+        entry.profile.throughputBytesPerSecond = static_cast<double>(throughput);
+
+        m_entries.push_back(std::move(entry));
+    }
+
+    TS_DLOGF("device profiles loaded: %d from %s", m_entries.size(), m_filePath.c_str());
+}
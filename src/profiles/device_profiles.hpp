@@ -0,0 +1,67 @@
+#ifndef SS_PROFILES_DEVICE_PROFILES_H
+#define SS_PROFILES_DEVICE_PROFILES_H
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Persisted cache of tuned per-device profiles (@see DeviceProbe).
+ * Text file, line per device: <major:minor> <rotational> <read size> <threads> <queue depth> <throughput> <model>
+ * MT: not thread-safe
+ */
+class DeviceProfileCache {
+public:
+    /**
+     * @brief loads cache if file exists, broken lines are skipped
+     * @param filePath - cache file path, empty => nothing loaded, saving is not possible
+     */
+    explicit DeviceProfileCache(const std::string& filePath);
+
+    /**
+     * @brief per-user cache file: $XDG_CACHE_HOME or ~/.cache based
+     * @return empty if no home directory
+     */
+    static std::string defaultFilePath();
+
+    const std::string& filePath() const;
+
+    /**
+     * @return false if device is not calibrated
+     */
+    bool find(const DeviceIdentity& identity, DeviceProfile& profile) const;
+
+    /**
+     * @brief add or replace device profile, call save() to persist
+     */
+    void store(const DeviceIdentity& identity, const DeviceProfile& profile);
+
+    /**
+     * @brief write cache file (via temporary file, so readers never see partial one)
+     * @throws on I/O errors
+     */
+    void save() const;
+
+private:
+    struct Entry {
+        DeviceIdentity identity;
+        DeviceProfile profile;
+    };
+
+    std::string m_filePath;
+    std::vector<Entry> m_entries;
+
+    void load();
+};
+
+
+} // ns ss
+
+
+#endif // SS_PROFILES_DEVICE_PROFILES_H
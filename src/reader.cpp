@@ -1,12 +1,55 @@
 #include "reader.hpp"
 
+#include <cassert>
+
 #include "types.hpp"
 
 
+ss::AbstractFileBlockReader::AbstractFileBlockReader(const FileSlicesScheme &fileSlicesScheme)
+    : m_fileSlicesScheme(fileSlicesScheme)
+{
+}
+
+
+std::string_view ss::AbstractFileBlockReader::readSingleBlock(size_t blockIndex)
+{
+    return readBlocks(blockIndex, 1);
+}
+
+
+std::string_view ss::AbstractFileBlockReader::readBlocks(size_t firstBlockIndex, size_t count)
+{
+    assert(count > 0 && "nothing to read");
+    assert(firstBlockIndex + count <= m_fileSlicesScheme.blockCount && "out of blocks range");
+
+    return doReadBlocks(firstBlockIndex, count);
+}
+
+
+const ss::FileSlicesScheme &ss::AbstractFileBlockReader::fileSlicesScheme() const
+{
+    return m_fileSlicesScheme;
+}
+
+
+void ss::AbstractFileBlockReader::setMemoryBudget(const MemoryBudgetPtr &budget)
+{
+    m_buffersLease = MemoryBudget::Lease(budget, m_buffersLease.bytes());
+}
+
+
+void ss::AbstractFileBlockReader::accountBuffersSize(SizeBytes bytes)
+{
+    m_buffersLease.resize(bytes);
+}
+
+
 ss::FileBlockReader::FileBlockReader(const std::string &inputFilePath, const FileSlicesScheme &fileSlicesScheme, const ss::SizeBytes readBufferSizeBytes)
-    : m_filePath(inputFilePath)
-    , m_fileSlicesScheme(fileSlicesScheme)
+    : AbstractFileBlockReader(fileSlicesScheme)
+    , m_filePath(inputFilePath)
 {
+    accountBuffersSize(readBufferSizeBytes + m_fileSlicesScheme.blockSizeBytes);
+
     if (readBufferSizeBytes > 0) {
         m_readBuffer.resize(readBufferSizeBytes);
         m_fileStream.rdbuf()->pubsetbuf(m_readBuffer.data(), readBufferSizeBytes);
@@ -21,17 +64,19 @@ ss::FileBlockReader::FileBlockReader(const std::string &inputFilePath, const Fil
 }
 
 
-ss::FileBlockReader::FileBlockReader(const FileBlockReader &inst)
-    : FileBlockReader(inst.m_filePath, inst.m_fileSlicesScheme, inst.m_readBuffer.size())
-{}
-
-
-std::string_view ss::FileBlockReader::readSingleBlock(size_t blockIndex)
+std::string_view ss::FileBlockReader::doReadBlocks(size_t firstBlockIndex, size_t count)
 {
+    const ss::SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    const ss::SizeBytes outputSize = blockSizeBytes * count;
+    if (m_blockBuffer.size() < static_cast<size_t>(outputSize)) {
+        accountBuffersSize(m_readBuffer.size() + outputSize);
+        m_blockBuffer.resize(outputSize);
+    }
+
     char* blockBuffer = m_blockBuffer.data();
-    const bool isLastBlock = (blockIndex == m_fileSlicesScheme.lastBlock.index);
+    const bool isLastBlockIncluded = (firstBlockIndex + count - 1 == m_fileSlicesScheme.lastBlock.index);
 
-    const ss::SizeBytes readPosition = m_fileSlicesScheme.blockSizeBytes * blockIndex;
+    const ss::SizeBytes readPosition = blockSizeBytes * firstBlockIndex;
 
     // avoid ssystem calls due perf
     if (readPosition != m_currentFilePosition) {
@@ -39,33 +84,38 @@ std::string_view ss::FileBlockReader::readSingleBlock(size_t blockIndex)
         m_currentFilePosition = readPosition;
     }
 
-    if (isLastBlock && m_fileSlicesScheme.lastBlock.needToFillUpWithZeros) {
-        if (m_fileSlicesScheme.lastBlock.realSizeBytes > 0) {
-            if (!m_fileStream.read(blockBuffer, m_fileSlicesScheme.lastBlock.realSizeBytes).good()) {
+    if (isLastBlockIncluded && m_fileSlicesScheme.lastBlock.needToFillUpWithZeros) {
+        const ss::SizeBytes realSizeBytes = outputSize - blockSizeBytes + m_fileSlicesScheme.lastBlock.realSizeBytes;
+        if (realSizeBytes > 0) {
+            if (!m_fileStream.read(blockBuffer, realSizeBytes).good()) {
                 throw std::runtime_error("block read error");
             }
-            m_currentFilePosition += m_fileSlicesScheme.lastBlock.realSizeBytes;
+            m_currentFilePosition += realSizeBytes;
         }
-        std::fill(m_blockBuffer.begin() + m_fileSlicesScheme.lastBlock.realSizeBytes, m_blockBuffer.end(), 0);
+        std::fill(blockBuffer + realSizeBytes, blockBuffer + outputSize, 0);
     } else {
-        if (!m_fileStream.read(blockBuffer, m_fileSlicesScheme.blockSizeBytes).good()) {
+        if (!m_fileStream.read(blockBuffer, outputSize).good()) {
             throw std::runtime_error("block read error");
         }
-        m_currentFilePosition += m_fileSlicesScheme.blockSizeBytes;
+        m_currentFilePosition += outputSize;
     }
-    return std::string_view(blockBuffer, m_fileSlicesScheme.blockSizeBytes);
+    return std::string_view(blockBuffer, outputSize);
 }
 
 
-const ss::FileSlicesScheme &ss::FileBlockReader::fileSlicesScheme() const
+ss::FileBlockReaderPtr ss::FileBlockReaderFactory::create()
 {
-    return m_fileSlicesScheme;
+    auto res = doCreate();
+    if (m_memoryBudget) {
+        res->setMemoryBudget(m_memoryBudget);
+    }
+    return res;
 }
 
 
-ss::FileBlockReaderPtr ss::FileBlockReaderFactory::create()
+void ss::FileBlockReaderFactory::setMemoryBudget(const MemoryBudgetPtr &budget)
 {
-    return doCreate();
+    m_memoryBudget = budget;
 }
 
 
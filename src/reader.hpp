@@ -9,31 +9,27 @@
 #include <functional>
 
 #include "slices_scheme.hpp"
+#include "memory_budget.hpp"
 
 
 namespace ss {
 
 
 /**
- * @brief Buffered file block reader
+ * @brief Abstract file block reader
  */
-class FileBlockReader {
+class AbstractFileBlockReader {
 public:
-    FileBlockReader(FileBlockReader&& inst) = delete;
-    FileBlockReader& operator=(const FileBlockReader& inst) = delete;
-    FileBlockReader& operator=(FileBlockReader&& inst) = delete;
-    ~FileBlockReader() = default;
-
+    AbstractFileBlockReader(const AbstractFileBlockReader& inst) = delete;
+    AbstractFileBlockReader(AbstractFileBlockReader&& inst) = delete;
+    AbstractFileBlockReader& operator=(const AbstractFileBlockReader& inst) = delete;
+    AbstractFileBlockReader& operator=(AbstractFileBlockReader&& inst) = delete;
 
     /**
-     * @param inputFilePath       - input file path
-     * @param fileSlicesScheme    - slices setup @see SlicesScheme
-     * @param readBufferSizeBytes - buffer size hint. 0 => autochoose
+     * @param fileSlicesScheme - slices setup @see SlicesScheme
      */
-    FileBlockReader(const std::string& inputFilePath,
-                const FileSlicesScheme& fileSlicesScheme,
-                const SizeBytes readBufferSizeBytes = 0);
-    FileBlockReader(const FileBlockReader& inst);
+    AbstractFileBlockReader(const FileSlicesScheme& fileSlicesScheme);
+    virtual ~AbstractFileBlockReader() = default;
 
     /**
      * @brief read block into internal buffer and return view to it
@@ -42,31 +38,82 @@ public:
      */
     std::string_view readSingleBlock(size_t blockIndex);
 
+    /**
+     * @brief read several sequental blocks into internal buffer and return view to it.
+     * Last block of file is filled up with zeros.
+     * View is valid till next read call
+     * @param firstBlockIndex - zero based index of first block
+     * @param count - count of blocks to read
+     * @return view to internal buffer of count * blockSize bytes
+     */
+    std::string_view readBlocks(size_t firstBlockIndex, size_t count);
+
     /**
      * @brief copy of original slices setup
      */
     const FileSlicesScheme& fileSlicesScheme() const;
 
+    /**
+     * @brief account internal buffers in budget, already allocated ones are acquired at once
+     */
+    void setMemoryBudget(const MemoryBudgetPtr& budget);
+
+protected:
+    const FileSlicesScheme m_fileSlicesScheme;
+
+    /**
+     * @brief must be called before buffers (re)allocation, growth waits for memory budget
+     * @param bytes - total size of internal buffers
+     */
+    void accountBuffersSize(SizeBytes bytes);
+
+private:
+    MemoryBudget::Lease m_buffersLease;
+
+    virtual std::string_view doReadBlocks(size_t firstBlockIndex, size_t count) = 0;
+};
+
+
+/**
+ * @brief Buffered (std::ifstream) file block reader
+ */
+class FileBlockReader : public AbstractFileBlockReader {
+public:
+    /**
+     * @param inputFilePath       - input file path
+     * @param fileSlicesScheme    - slices setup @see SlicesScheme
+     * @param readBufferSizeBytes - buffer size hint. 0 => autochoose
+     */
+    FileBlockReader(const std::string& inputFilePath,
+                const FileSlicesScheme& fileSlicesScheme,
+                const SizeBytes readBufferSizeBytes = 0);
+
 private:
     const std::string m_filePath;
-    const FileSlicesScheme m_fileSlicesScheme;
     std::ifstream m_fileStream;
 
     std::vector<char> m_readBuffer;
     std::vector<char> m_blockBuffer;
 
     ss::SizeBytes m_currentFilePosition = 0;
+
+    std::string_view doReadBlocks(size_t firstBlockIndex, size_t count) override;
 };
 
 
-using FileBlockReaderPtr = std::shared_ptr<FileBlockReader>;
+using FileBlockReaderPtr = std::shared_ptr<AbstractFileBlockReader>;
 
 
 class FileBlockReaderFactory {
 public:
     virtual ~FileBlockReaderFactory() {}
     FileBlockReaderPtr create();
+    /**
+     * @brief buffers of created readers are accounted in budget
+     */
+    void setMemoryBudget(const MemoryBudgetPtr& budget);
 private:
+    MemoryBudgetPtr m_memoryBudget;
     virtual FileBlockReaderPtr doCreate() = 0;
 };
 
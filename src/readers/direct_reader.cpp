@@ -0,0 +1,86 @@
+#include "direct_reader.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+#include <tools/log.hpp>
+
+
+TS_LOGGER("reader.direct")
+
+
+namespace {
+
+
+ss::SizeBytes alignUp(ss::SizeBytes value, ss::SizeBytes alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+
+} // ns anonymous
+
+
+ss::DirectFileBlockReader::DirectFileBlockReader(const FileDescriptorPtr &file, const FileSlicesScheme &fileSlicesScheme, const SizeBytes alignmentBytes)
+    : AbstractFileBlockReader(fileSlicesScheme)
+    , m_file(file)
+    , m_alignmentBytes(alignmentBytes)
+    , m_buffer(0, alignmentBytes)
+{
+}
+
+
+ss::FileDescriptorPtr ss::DirectFileBlockReader::openFile(const std::string &filePath)
+{
+#if defined(O_DIRECT)
+    try {
+        return std::make_shared<FileDescriptor>(filePath, O_DIRECT);
+    } catch (const std::system_error& e) {
+        // EINVAL => file system doesn't support direct I/O
+        if (e.code() != std::errc::invalid_argument) {
+            throw;
+        }
+    }
+#endif
+    TS_WLOGF("direct I/O is not supported for: %s, fallback to buffered reads", filePath.c_str());
+    return std::make_shared<FileDescriptor>(filePath);
+}
+
+
+std::string_view ss::DirectFileBlockReader::doReadBlocks(size_t firstBlockIndex, size_t count)
+{
+    const SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    const SizeBytes outputSize = blockSizeBytes * count;
+    const SizeBytes readPosition = blockSizeBytes * firstBlockIndex;
+    const SizeBytes dataEnd = std::min(readPosition + outputSize, m_fileSlicesScheme.fileSizeBytes);
+
+    // extend range to aligned one: head - down to alignment, tail - up (read stops at end of file)
+    const SizeBytes alignedReadPosition = readPosition / m_alignmentBytes * m_alignmentBytes;
+    const SizeBytes headSkip = readPosition - alignedReadPosition;
+    const SizeBytes alignedReadSize = alignUp(dataEnd - alignedReadPosition, m_alignmentBytes);
+
+    const SizeBytes bufferSizeBytes = std::max(alignedReadSize, alignUp(headSkip + outputSize, m_alignmentBytes));
+    accountBuffersSize(std::max<SizeBytes>(m_buffer.size(), bufferSizeBytes));
+    m_buffer.reserve(bufferSizeBytes);
+    char* buffer = m_buffer.data();
+
+    if (dataEnd > readPosition) {
+        const SizeBytes readBytes = m_file->readUpTo(buffer, alignedReadSize, alignedReadPosition);
+        if (alignedReadPosition + readBytes < dataEnd) {
+            throw std::runtime_error("block read error: unexpected end of file");
+        }
+    }
+
+    // last partial block: fill up with zeros in place
+    const SizeBytes realSizeBytes = dataEnd > readPosition ? dataEnd - readPosition : 0;
+    if (realSizeBytes < outputSize) {
+        std::fill(buffer + headSkip + realSizeBytes, buffer + headSkip + outputSize, 0);
+    }
+
+    return std::string_view(buffer + headSkip, outputSize);
+}
@@ -0,0 +1,52 @@
+#ifndef SS_READERS_DIRECT_READER_H
+#define SS_READERS_DIRECT_READER_H
+#pragma once
+
+#include <tools/aligned_buffer.hpp>
+
+#include "reader.hpp"
+#include "readers/file_descriptor.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Direct I/O (O_DIRECT) file block reader: bypasses OS page cache, so signing huge files
+ * doesn't evict other processes data. Requested ranges are extended to sector aligned ones and
+ * read into own aligned buffer (one per reader => per worker buffers pool), returned view skips
+ * aligned head. Unaligned file tail and block sizes not multiple of sector size are supported.
+ * POSIX only
+ */
+class DirectFileBlockReader : public AbstractFileBlockReader {
+public:
+    /**
+     * @param file              - input file opened by openFile(), may be shared with other readers
+     * @param fileSlicesScheme  - slices setup @see SlicesScheme
+     * @param alignmentBytes    - offsets, sizes and buffers alignment, multiple of logical sector size
+     */
+    DirectFileBlockReader(const FileDescriptorPtr& file,
+                const FileSlicesScheme& fileSlicesScheme,
+                const SizeBytes alignmentBytes = kDefaultAlignmentBytes);
+
+    static constexpr const SizeBytes kDefaultAlignmentBytes = 4096;
+
+    /**
+     * @brief open file for direct I/O. If file system doesn't support it (tmpfs etc) -
+     * falls back to regular buffered descriptor with warning
+     */
+    static FileDescriptorPtr openFile(const std::string& filePath);
+
+private:
+    FileDescriptorPtr m_file;
+    const SizeBytes m_alignmentBytes;
+    tools::AlignedBuffer m_buffer;
+
+    std::string_view doReadBlocks(size_t firstBlockIndex, size_t count) override;
+};
+
+
+} // ns ss
+
+
+#endif // SS_READERS_DIRECT_READER_H
@@ -0,0 +1,115 @@
+#include "file_descriptor.hpp"
+
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+ss::FileDescriptor::FileDescriptor(const std::string &filePath, int extraFlags)
+    : m_filePath(filePath)
+{
+#ifdef _WIN32
+    (void)extraFlags;
+    throw std::runtime_error("positional reads are not supported on this platform");
+#else
+    m_fd = ::open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC | extraFlags);
+    if (m_fd < 0) {
+        const int error = errno;
+        throw std::system_error(error, std::generic_category(), "failed to open in file: " + filePath);
+    }
+#endif
+}
+
+
+ss::FileDescriptor::~FileDescriptor()
+{
+#ifndef _WIN32
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+
+int ss::FileDescriptor::fd() const
+{
+    return m_fd;
+}
+
+
+const std::string &ss::FileDescriptor::filePath() const
+{
+    return m_filePath;
+}
+
+
+void ss::FileDescriptor::readFully(char *buffer, SizeBytes size, SizeBytes position) const
+{
+    if (readUpTo(buffer, size, position) < size) {
+        throw std::runtime_error("block read error: unexpected end of file");
+    }
+}
+
+
+ss::SizeBytes ss::FileDescriptor::readUpTo(char *buffer, SizeBytes size, SizeBytes position) const
+{
+    SizeBytes done = 0;
+#ifndef _WIN32
+    while (done < size) {
+        const ssize_t res = ::pread(m_fd, buffer + done, size - done, position + done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("block read error: ") + std::strerror(errno));
+        }
+        if (res == 0) {
+            break;
+        }
+        done += res;
+    }
+#else
+    (void)buffer;
+    (void)size;
+    (void)position;
+#endif
+    return done;
+}
+
+
+void ss::FileDescriptor::adviseSequentalAccess() const
+{
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+
+void ss::FileDescriptor::adviseWillNeed(SizeBytes position, SizeBytes size) const
+{
+#if defined(__linux__)
+    ::readahead(m_fd, position, size);
+#elif !defined(_WIN32) && defined(POSIX_FADV_WILLNEED)
+    ::posix_fadvise(m_fd, position, size, POSIX_FADV_WILLNEED);
+#else
+    (void)position;
+    (void)size;
+#endif
+}
+
+
+void ss::FileDescriptor::adviseDontNeed(SizeBytes position, SizeBytes size) const
+{
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+    ::posix_fadvise(m_fd, position, size, POSIX_FADV_DONTNEED);
+#else
+    (void)position;
+    (void)size;
+#endif
+}
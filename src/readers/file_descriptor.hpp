@@ -0,0 +1,79 @@
+#ifndef SS_READERS_FILE_DESCRIPTOR_H
+#define SS_READERS_FILE_DESCRIPTOR_H
+#pragma once
+
+#include <string>
+#include <memory>
+
+#include "types.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief RAII owner of read-only POSIX file descriptor.
+ * Positional reads are stateless => single instance can be shared by any count of readers/threads
+ * MT: readFully is thread-safe
+ */
+class FileDescriptor {
+public:
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor(FileDescriptor&&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+    /**
+     * @param filePath - file to open read-only
+     * @param extraFlags - additional open(2) flags
+     * @throws std::system_error with errno code on open failure
+     */
+    FileDescriptor(const std::string& filePath, int extraFlags = 0);
+    ~FileDescriptor();
+
+    int fd() const;
+    const std::string& filePath() const;
+
+    /**
+     * @brief positional read (pread) of exactly given size, retries short reads
+     * @throws on error or unexpected end of file
+     */
+    void readFully(char* buffer, SizeBytes size, SizeBytes position) const;
+
+    /**
+     * @brief positional read (pread) of up to given size, retries short reads till end of file
+     * @return count of read bytes, less then size only at end of file
+     * @throws on error
+     */
+    SizeBytes readUpTo(char* buffer, SizeBytes size, SizeBytes position) const;
+
+    // access pattern hints to OS (no-op if not supported), errors are ignored
+
+    /**
+     * @brief file will be read sequentally => more aggressive OS read-ahead
+     */
+    void adviseSequentalAccess() const;
+
+    /**
+     * @brief start async loading of given range into OS page cache (readahead)
+     */
+    void adviseWillNeed(SizeBytes position, SizeBytes size) const;
+
+    /**
+     * @brief given range is not needed anymore => OS may drop it from page cache
+     */
+    void adviseDontNeed(SizeBytes position, SizeBytes size) const;
+
+private:
+    const std::string m_filePath;
+    int m_fd = -1;
+};
+
+
+using FileDescriptorPtr = std::shared_ptr<FileDescriptor>;
+
+
+} // ns ss
+
+
+#endif // SS_READERS_FILE_DESCRIPTOR_H
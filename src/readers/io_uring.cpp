@@ -0,0 +1,288 @@
+#include "io_uring.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define SS_IO_URING_AVAILABLE 1
+#else
+#define SS_IO_URING_AVAILABLE 0
+#endif
+
+
+#if SS_IO_URING_AVAILABLE
+
+namespace {
+
+
+/// opcodes probe capacity, opcode is 8 bit
+constexpr const unsigned kProbeOpsCount = 256;
+
+
+bool isDisabledByEnvironment()
+{
+    const char* value = std::getenv("SEGMENTED_SIGNATURE_DISABLE_IO_URING");
+    return value != nullptr && *value != '\0' && std::strcmp(value, "0") != 0;
+}
+
+
+int ioUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+
+int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+
+int ioUringRegister(int ringFd, unsigned opcode, void* arg, unsigned argsCount)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, arg, argsCount));
+}
+
+
+template<typename T>
+T* ringPtr(void* ring, uint32_t offset)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+
+} // ns anonymous
+
+
+ss::IoUring::IoUring(unsigned queueDepth)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    m_ringFd = ioUringSetup(queueDepth, &params);
+    if (m_ringFd < 0) {
+        throw std::runtime_error(std::string("io_uring setup failed: ") + std::strerror(errno));
+    }
+    m_entries = params.sq_entries;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+    }
+
+    m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED) {
+        m_sqRing = nullptr;
+        release();
+        throw std::runtime_error("io_uring submission ring map failed");
+    }
+
+    if (singleMap) {
+        m_cqRing = m_sqRing;
+    } else {
+        m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+        if (m_cqRing == MAP_FAILED) {
+            m_cqRing = nullptr;
+            release();
+            throw std::runtime_error("io_uring completion ring map failed");
+        }
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+    if (m_sqes == MAP_FAILED) {
+        m_sqes = nullptr;
+        release();
+        throw std::runtime_error("io_uring submission entries map failed");
+    }
+
+    m_sqHead = ringPtr<unsigned>(m_sqRing, params.sq_off.head);
+    m_sqTail = ringPtr<unsigned>(m_sqRing, params.sq_off.tail);
+    m_sqMask = ringPtr<unsigned>(m_sqRing, params.sq_off.ring_mask);
+    m_sqArray = ringPtr<unsigned>(m_sqRing, params.sq_off.array);
+
+    m_cqHead = ringPtr<unsigned>(m_cqRing, params.cq_off.head);
+    m_cqTail = ringPtr<unsigned>(m_cqRing, params.cq_off.tail);
+    m_cqMask = ringPtr<unsigned>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = ringPtr<void>(m_cqRing, params.cq_off.cqes);
+}
+
+
+ss::IoUring::~IoUring()
+{
+    release();
+}
+
+
+bool ss::IoUring::isSupported()
+{
+    static const bool supported = []() {
+        if (isDisabledByEnvironment()) {
+            return false;
+        }
+        try {
+            // NOTE: setup works since 5.1, but reads are submitted as IORING_OP_READ - since 5.6
+            IoUring ring(1);
+            return ring.isOpcodeSupported(IORING_OP_READ);
+        } catch (...) {
+            return false;
+        }
+    }();
+    return supported;
+}
+
+
+bool ss::IoUring::isOpcodeSupported(uint8_t opcode) const
+{
+    // probe is followed by ops array
+    std::vector<char> probeData(sizeof(io_uring_probe) + kProbeOpsCount * sizeof(io_uring_probe_op), 0);
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeData.data());
+    if (ioUringRegister(m_ringFd, IORING_REGISTER_PROBE, probe, kProbeOpsCount) < 0) {
+        return false;
+    }
+    return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+
+bool ss::IoUring::prepareRead(int fd, char *buffer, uint32_t size, uint64_t position, uint64_t userData)
+{
+    const unsigned tail = *m_sqTail;
+    const unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= m_entries) {
+        return false;
+    }
+
+    const unsigned index = tail & *m_sqMask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(m_sqes) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = size;
+    sqe->off = position;
+    sqe->user_data = userData;
+
+    m_sqArray[index] = index;
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++m_toSubmit;
+    return true;
+}
+
+
+void ss::IoUring::submit(unsigned waitCount)
+{
+    const unsigned flags = waitCount > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (m_toSubmit > 0 || waitCount > 0) {
+        const int res = ioUringEnter(m_ringFd, m_toSubmit, waitCount, flags);
+        if (res < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            throw std::runtime_error(std::string("io_uring enter failed: ") + std::strerror(errno));
+        }
+        m_toSubmit -= std::min<unsigned>(m_toSubmit, res);
+        // wait is satisfied by successful call with GETEVENTS
+        waitCount = 0;
+    }
+}
+
+
+bool ss::IoUring::popCompletion(Completion &completion)
+{
+    const unsigned head = *m_cqHead;
+    const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+        return false;
+    }
+
+    const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(m_cqes) + (head & *m_cqMask);
+    completion.userData = cqe->user_data;
+    completion.result = cqe->res;
+
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+
+void ss::IoUring::release() noexcept
+{
+    if (m_sqes != nullptr) {
+        ::munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+        ::munmap(m_cqRing, m_cqRingSize);
+    }
+    m_cqRing = nullptr;
+    if (m_sqRing != nullptr) {
+        ::munmap(m_sqRing, m_sqRingSize);
+        m_sqRing = nullptr;
+    }
+    if (m_ringFd >= 0) {
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+}
+
+#else // SS_IO_URING_AVAILABLE
+
+ss::IoUring::IoUring(unsigned queueDepth)
+{
+    (void)queueDepth;
+    throw std::runtime_error("io_uring is not supported on this platform");
+}
+
+
+ss::IoUring::~IoUring()
+{
+}
+
+
+bool ss::IoUring::isSupported()
+{
+    return false;
+}
+
+
+bool ss::IoUring::isOpcodeSupported(uint8_t) const
+{
+    return false;
+}
+
+
+bool ss::IoUring::prepareRead(int, char *, uint32_t, uint64_t, uint64_t)
+{
+    return false;
+}
+
+
+void ss::IoUring::submit(unsigned)
+{
+}
+
+
+bool ss::IoUring::popCompletion(Completion &)
+{
+    return false;
+}
+
+
+void ss::IoUring::release() noexcept
+{
+}
+
+#endif // SS_IO_URING_AVAILABLE
@@ -0,0 +1,95 @@
+#ifndef SS_READERS_IO_URING_H
+#define SS_READERS_IO_URING_H
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace ss {
+
+
+/**
+ * @brief Minimal io_uring instance (raw syscalls, no liburing): submission of positional
+ * reads and reaping of their completions. Linux only, @see isSupported
+ * NOTE: kernel rings are shared with kernel by mapping ring fd - input file itself is never mapped
+ * MT: not thread-safe, single owner thread
+ */
+class IoUring {
+public:
+    IoUring(const IoUring&) = delete;
+    IoUring(IoUring&&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    IoUring& operator=(IoUring&&) = delete;
+
+    /**
+     * @param queueDepth - max count of submitted and not reaped requests
+     * @throws if io_uring is not available
+     */
+    IoUring(unsigned queueDepth);
+    ~IoUring();
+
+    struct Completion {
+        uint64_t userData = 0;
+        int32_t result = 0;     ///< bytes read or -errno
+    };
+
+    /**
+     * @brief is io_uring available in running kernel (not disabled, not filtered etc) and supports
+     * positional reads (IORING_OP_READ, since 5.6). Checked once.
+     * Environment SEGMENTED_SIGNATURE_DISABLE_IO_URING=1 forces unsupported one (fallback testing)
+     */
+    static bool isSupported();
+
+    /**
+     * @brief queue read request, call submit() to pass queued requests to kernel
+     * @return false if submission queue is full
+     */
+    bool prepareRead(int fd, char* buffer, uint32_t size, uint64_t position, uint64_t userData);
+
+    /**
+     * @brief pass queued requests to kernel and optionally wait for completions
+     * @param waitCount - min completions count to wait for
+     */
+    void submit(unsigned waitCount = 0);
+
+    /**
+     * @brief reap single completion without waiting
+     * @return false if no completed requests
+     */
+    bool popCompletion(Completion& completion);
+
+private:
+    int m_ringFd = -1;
+
+    // submission queue
+    void* m_sqRing = nullptr;
+    size_t m_sqRingSize = 0;
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqMask = nullptr;
+    unsigned* m_sqArray = nullptr;
+    void* m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+    unsigned m_toSubmit = 0;
+
+    // completion queue
+    void* m_cqRing = nullptr;
+    size_t m_cqRingSize = 0;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqMask = nullptr;
+    void* m_cqes = nullptr;
+
+    unsigned m_entries = 0;
+
+    /// operation support by opcodes probe, no probe (before 5.6) - not supported
+    bool isOpcodeSupported(uint8_t opcode) const;
+    void release() noexcept;
+};
+
+
+} // ns ss
+
+
+#endif // SS_READERS_IO_URING_H
@@ -0,0 +1,35 @@
+#include "positional_reader.hpp"
+
+#include <algorithm>
+
+
+ss::PositionalFileBlockReader::PositionalFileBlockReader(const FileDescriptorPtr &file, const FileSlicesScheme &fileSlicesScheme)
+    : AbstractFileBlockReader(fileSlicesScheme)
+    , m_file(file)
+{
+    m_file->adviseSequentalAccess();
+}
+
+
+std::string_view ss::PositionalFileBlockReader::doReadBlocks(size_t firstBlockIndex, size_t count)
+{
+    const SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    const SizeBytes outputSize = blockSizeBytes * count;
+    const SizeBytes readPosition = blockSizeBytes * firstBlockIndex;
+    const SizeBytes realSizeBytes = std::min(outputSize, m_fileSlicesScheme.fileSizeBytes - readPosition);
+
+    accountBuffersSize(std::max<SizeBytes>(m_buffer.size(), outputSize));
+    m_buffer.reserve(outputSize);
+    char* buffer = m_buffer.data();
+
+    if (realSizeBytes > 0) {
+        m_file->readFully(buffer, realSizeBytes, readPosition);
+    }
+
+    // last partial block: fill up with zeros in place
+    if (realSizeBytes < outputSize) {
+        std::fill(buffer + realSizeBytes, buffer + outputSize, 0);
+    }
+
+    return std::string_view(buffer, outputSize);
+}
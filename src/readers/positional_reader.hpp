@@ -0,0 +1,40 @@
+#ifndef SS_READERS_POSITIONAL_READER_H
+#define SS_READERS_POSITIONAL_READER_H
+#pragma once
+
+#include <tools/aligned_buffer.hpp>
+
+#include "reader.hpp"
+#include "readers/file_descriptor.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Positional file block reader: reads exactly requested ranges by pread from
+ * file descriptor shared with other readers. No own file handle, no seeks, no read-ahead,
+ * so reader is cheap to create and any reader can read any range.
+ * POSIX only
+ */
+class PositionalFileBlockReader : public AbstractFileBlockReader {
+public:
+    /**
+     * @param file              - shared opened input file
+     * @param fileSlicesScheme  - slices setup @see SlicesScheme
+     */
+    PositionalFileBlockReader(const FileDescriptorPtr& file,
+                const FileSlicesScheme& fileSlicesScheme);
+
+private:
+    FileDescriptorPtr m_file;
+    tools::AlignedBuffer m_buffer;
+
+    std::string_view doReadBlocks(size_t firstBlockIndex, size_t count) override;
+};
+
+
+} // ns ss
+
+
+#endif // SS_READERS_POSITIONAL_READER_H
@@ -0,0 +1,198 @@
+#include "uring_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+
+
+/// single request len is 32 bit, keep it round
+constexpr const ss::SizeBytes kMaxSingleReadSizeBytes = 1 * ss::kGigaBytes;
+
+
+} // ns anonymous
+
+
+ss::UringRangesReader::UringRangesReader(const FileDescriptorPtr &file,
+        const FileSlicesScheme &fileSlicesScheme,
+        size_t rangeBlocksCount,
+        size_t queueDepth,
+        size_t buffersCount,
+        const MemoryBudgetPtr &memoryBudget)
+    : m_file(file)
+    , m_fileSlicesScheme(fileSlicesScheme)
+    , m_rangeBlocksCount(std::max<size_t>(1, rangeBlocksCount))
+    , m_queueDepth(std::max<size_t>(1, queueDepth))
+    , m_maxBuffersCount(std::max<size_t>(1, buffersCount))
+    , m_bufferSizeBytes(m_rangeBlocksCount * m_fileSlicesScheme.blockSizeBytes)
+    , m_ring(static_cast<unsigned>(m_queueDepth))
+    , m_buffersLease(memoryBudget)
+{
+    // NOTE: no reallocations => buffers are not moved while hashed
+    m_buffers.reserve(m_maxBuffersCount);
+    m_freeBuffers.reserve(m_maxBuffersCount);
+    m_slots.resize(m_maxBuffersCount);
+}
+
+
+bool ss::UringRangesReader::isFinished() const
+{
+    return m_readsInFlight == 0 && m_nextBlockIndex >= m_fileSlicesScheme.blockCount;
+}
+
+
+bool ss::UringRangesReader::hasReadsInFlight() const
+{
+    return m_readsInFlight > 0;
+}
+
+
+void ss::UringRangesReader::submitReads(size_t endBlockIndex)
+{
+    const SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    endBlockIndex = std::min(endBlockIndex, m_fileSlicesScheme.blockCount);
+
+    while (m_readsInFlight < m_queueDepth && m_nextBlockIndex < endBlockIndex) {
+        size_t bufferIndex = 0;
+        bool isFreeBufferTaken = false;
+        {
+            std::lock_guard<std::mutex> guard(m_mutFreeBuffers);
+            if (!m_freeBuffers.empty()) {
+                bufferIndex = m_freeBuffers.back();
+                m_freeBuffers.pop_back();
+                isFreeBufferTaken = true;
+            }
+        }
+        if (!isFreeBufferTaken && !allocateBuffer(bufferIndex)) {
+            break;
+        }
+
+        Slot& slot = m_slots[bufferIndex];
+        slot.firstBlockIndex = m_nextBlockIndex;
+        slot.count = std::min(m_rangeBlocksCount, m_fileSlicesScheme.blockCount - m_nextBlockIndex);
+        slot.position = slot.firstBlockIndex * blockSizeBytes;
+        slot.size = std::min<SizeBytes>(slot.count * blockSizeBytes, m_fileSlicesScheme.fileSizeBytes - slot.position);
+        slot.done = 0;
+
+        m_nextBlockIndex += slot.count;
+        ++m_readsInFlight;
+
+        submitSlotRead(bufferIndex);
+    }
+
+    m_ring.submit();
+}
+
+
+void ss::UringRangesReader::waitCompletedRanges(std::vector<Range> &ranges)
+{
+    if (m_readsInFlight == 0) {
+        if (m_nextBlockIndex < m_fileSlicesScheme.blockCount) {
+            std::unique_lock<std::mutex> guard(m_mutFreeBuffers);
+            m_cvBufferReleased.wait(guard, [this]() {
+                return !m_freeBuffers.empty();
+            });
+        }
+        return;
+    }
+
+    m_ring.submit(1);
+
+    const SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+
+    IoUring::Completion completion;
+    while (m_ring.popCompletion(completion)) {
+        const size_t bufferIndex = static_cast<size_t>(completion.userData);
+        Slot& slot = m_slots[bufferIndex];
+
+        if (completion.result < 0) {
+            if (completion.result == -EINTR || completion.result == -EAGAIN) {
+                submitSlotRead(bufferIndex);
+                continue;
+            }
+            throw std::runtime_error(std::string("block read error: ") + std::strerror(-completion.result));
+        }
+        if (completion.result == 0 && slot.done < slot.size) {
+            throw std::runtime_error("block read error: unexpected end of file");
+        }
+
+        slot.done += completion.result;
+        if (slot.done < slot.size) {
+            // short read - continue with rest
+            submitSlotRead(bufferIndex);
+            continue;
+        }
+
+        --m_readsInFlight;
+
+        const SizeBytes outputSize = slot.count * blockSizeBytes;
+        char* buffer = m_buffers[bufferIndex].data();
+
+        // last partial block: fill up with zeros in place
+        if (slot.size < outputSize) {
+            std::fill(buffer + slot.size, buffer + outputSize, 0);
+        }
+
+        Range range;
+        range.firstBlockIndex = slot.firstBlockIndex;
+        range.count = slot.count;
+        range.data = std::string_view(buffer, outputSize);
+        range.bufferIndex = bufferIndex;
+        ranges.push_back(range);
+    }
+
+    // resubmitted short reads
+    m_ring.submit();
+}
+
+
+void ss::UringRangesReader::releaseBuffer(size_t bufferIndex)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutFreeBuffers);
+        m_freeBuffers.push_back(bufferIndex);
+    }
+    m_cvBufferReleased.notify_one();
+}
+
+
+bool ss::UringRangesReader::allocateBuffer(size_t &bufferIndex)
+{
+    if (m_buffers.size() >= m_maxBuffersCount) {
+        return false;
+    }
+
+    // first buffer is a must to make progress, others are read-ahead => only if budget allows
+    const SizeBytes buffersSizeBytes = (m_buffers.size() + 1) * m_bufferSizeBytes;
+    if (m_buffers.empty()) {
+        m_buffersLease.resize(buffersSizeBytes);
+    } else if (!m_buffersLease.tryResize(buffersSizeBytes)) {
+        return false;
+    }
+
+    bufferIndex = m_buffers.size();
+    m_buffers.emplace_back(m_bufferSizeBytes);
+    return true;
+}
+
+
+void ss::UringRangesReader::submitSlotRead(size_t bufferIndex)
+{
+    Slot& slot = m_slots[bufferIndex];
+
+    // NOTE: nothing to read (empty file) => zero sized read, completes with 0
+    const SizeBytes size = std::min<SizeBytes>(slot.size - slot.done, kMaxSingleReadSizeBytes);
+    const bool queued = m_ring.prepareRead(
+                m_file->fd(),
+                m_buffers[bufferIndex].data() + slot.done,
+                static_cast<uint32_t>(size),
+                slot.position + slot.done,
+                bufferIndex);
+
+    if (!queued) {
+        throw std::runtime_error("io_uring submission queue overflow");
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef SS_READERS_URING_READER_H
+#define SS_READERS_URING_READER_H
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+#include <tools/aligned_buffer.hpp>
+
+#include "slices_scheme.hpp"
+#include "memory_budget.hpp"
+#include "readers/file_descriptor.hpp"
+#include "readers/io_uring.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Asynchronous (io_uring) sequental ranges reader: keeps up to queue depth reads in flight
+ * into ring of buffers (allocated on demand while memory budget allows), completed ranges are handed out to be hashed by other threads and
+ * returned back by releaseBuffer(). Ranges are read in file order, but may complete in any order.
+ * Linux only, @see IoUring::isSupported
+ * MT: releaseBuffer is thread-safe, other methods - owner thread only
+ */
+class UringRangesReader {
+public:
+    UringRangesReader(const UringRangesReader&) = delete;
+    UringRangesReader(UringRangesReader&&) = delete;
+    UringRangesReader& operator=(const UringRangesReader&) = delete;
+    UringRangesReader& operator=(UringRangesReader&&) = delete;
+
+    /**
+     * @param file              - shared opened input file
+     * @param fileSlicesScheme  - slices setup @see SlicesScheme
+     * @param rangeBlocksCount  - blocks count in single range (single read)
+     * @param queueDepth        - max reads in flight
+     * @param buffersCount      - max count of range buffers, >= queueDepth to keep queue full while hashing
+     * @param memoryBudget      - [optional] buffers are accounted in it, first one waits for budget, others - only if available
+     */
+    UringRangesReader(const FileDescriptorPtr& file,
+            const FileSlicesScheme& fileSlicesScheme,
+            size_t rangeBlocksCount,
+            size_t queueDepth,
+            size_t buffersCount,
+            const MemoryBudgetPtr& memoryBudget = nullptr);
+
+    /// completed range, valid till releaseBuffer(bufferIndex)
+    struct Range {
+        size_t firstBlockIndex = 0;
+        size_t count = 0;
+        std::string_view data;      ///< count * blockSize bytes, last block of file is filled up with zeros
+        size_t bufferIndex = 0;
+    };
+
+    /**
+     * @brief all ranges are read and handed out
+     */
+    bool isFinished() const;
+
+    bool hasReadsInFlight() const;
+
+    /**
+     * @brief start reads of next ranges into free buffers while queue is not full
+     * @param endBlockIndex - ranges starting from this block are not started yet (consumer backpressure)
+     */
+    void submitReads(size_t endBlockIndex = static_cast<size_t>(-1));
+
+    /**
+     * @brief wait for at least one completed range (or free buffer if nothing is in flight)
+     * @param ranges - output, completed ranges are appended
+     */
+    void waitCompletedRanges(std::vector<Range>& ranges);
+
+    /**
+     * @brief return range buffer back to reuse
+     */
+    void releaseBuffer(size_t bufferIndex);
+
+private:
+    /// read in progress
+    struct Slot {
+        size_t firstBlockIndex = 0;
+        size_t count = 0;
+        SizeBytes position = 0;
+        SizeBytes size = 0;     ///< real (in file) size
+        SizeBytes done = 0;
+    };
+
+    const FileDescriptorPtr m_file;
+    const FileSlicesScheme m_fileSlicesScheme;
+    const size_t m_rangeBlocksCount;
+    const size_t m_queueDepth;
+    const size_t m_maxBuffersCount;
+    const SizeBytes m_bufferSizeBytes;
+
+    IoUring m_ring;
+    std::vector<tools::AlignedBuffer> m_buffers;
+    std::vector<Slot> m_slots;                      ///< by buffer index
+    MemoryBudget::Lease m_buffersLease;
+
+    std::mutex m_mutFreeBuffers;
+    std::condition_variable m_cvBufferReleased;
+    std::vector<size_t> m_freeBuffers;
+
+    size_t m_readsInFlight = 0;
+    size_t m_nextBlockIndex = 0;
+
+    void submitSlotRead(size_t bufferIndex);
+
+    /**
+     * @return false if max count of buffers is reached or no memory budget available
+     */
+    bool allocateBuffer(size_t& bufferIndex);
+};
+
+
+} // ns ss
+
+
+#endif // SS_READERS_URING_READER_H
@@ -0,0 +1,66 @@
+#include "zero_copy_reader.hpp"
+
+#include <algorithm>
+
+#include "consts.hpp"
+
+
+ss::ZeroCopyFileBlockReader::ZeroCopyFileBlockReader(const FileDescriptorPtr &file, const FileSlicesScheme &fileSlicesScheme, const SizeBytes chunkSizeBytes)
+    : AbstractFileBlockReader(fileSlicesScheme)
+    , m_file(file)
+{
+    const SizeBytes effChunkSizeBytes = chunkSizeBytes > 0
+            ? chunkSizeBytes
+            : ss::kDefaultSingleThreadSequentalRangeSize;
+
+    m_chunkBlocksCount = std::max<size_t>(1, effChunkSizeBytes / m_fileSlicesScheme.blockSizeBytes);
+
+    m_file->adviseSequentalAccess();
+}
+
+
+std::string_view ss::ZeroCopyFileBlockReader::doReadBlocks(size_t firstBlockIndex, size_t count)
+{
+    const bool isLoaded = m_loadedBlocksCount > 0
+            && firstBlockIndex >= m_loadedFirstBlockIndex
+            && firstBlockIndex + count <= m_loadedFirstBlockIndex + m_loadedBlocksCount;
+
+    if (!isLoaded) {
+        // read whole chunk ahead, but not out of file
+        const size_t chunkBlocksCount = std::min(
+                    std::max(count, m_chunkBlocksCount),
+                    m_fileSlicesScheme.blockCount - firstBlockIndex);
+        loadChunk(firstBlockIndex, chunkBlocksCount);
+    }
+
+    const size_t blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    return std::string_view(
+                m_chunkBuffer.data() + (firstBlockIndex - m_loadedFirstBlockIndex) * blockSizeBytes,
+                count * blockSizeBytes);
+}
+
+
+void ss::ZeroCopyFileBlockReader::loadChunk(size_t firstBlockIndex, size_t count)
+{
+    const SizeBytes blockSizeBytes = m_fileSlicesScheme.blockSizeBytes;
+    const SizeBytes chunkSizeBytes = blockSizeBytes * count;
+    const SizeBytes readPosition = blockSizeBytes * firstBlockIndex;
+    const SizeBytes realSizeBytes = std::min(chunkSizeBytes, m_fileSlicesScheme.fileSizeBytes - readPosition);
+
+    m_loadedBlocksCount = 0;
+    accountBuffersSize(std::max<SizeBytes>(m_chunkBuffer.size(), chunkSizeBytes));
+    m_chunkBuffer.reserve(chunkSizeBytes);
+    char* buffer = m_chunkBuffer.data();
+
+    if (realSizeBytes > 0) {
+        m_file->readFully(buffer, realSizeBytes, readPosition);
+    }
+
+    // last partial block: fill up with zeros in place
+    if (realSizeBytes < chunkSizeBytes) {
+        std::fill(buffer + realSizeBytes, buffer + chunkSizeBytes, 0);
+    }
+
+    m_loadedFirstBlockIndex = firstBlockIndex;
+    m_loadedBlocksCount = count;
+}
@@ -0,0 +1,49 @@
+#ifndef SS_READERS_ZERO_COPY_READER_H
+#define SS_READERS_ZERO_COPY_READER_H
+#pragma once
+
+#include <string>
+
+#include <tools/aligned_buffer.hpp>
+
+#include "reader.hpp"
+#include "readers/file_descriptor.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Zero-copy file block reader: reads large chunks by plain positional reads (pread)
+ * into single aligned buffer and returns views of blocks inside it. No stream buffer =>
+ * file data copied only once (kernel -> chunk buffer), last partial block is zero filled in place.
+ * POSIX only
+ */
+class ZeroCopyFileBlockReader : public AbstractFileBlockReader {
+public:
+    /**
+     * @param file                 - opened input file, may be shared with other readers
+     * @param fileSlicesScheme     - slices setup @see SlicesScheme
+     * @param chunkSizeBytes       - size of single read. 0 => autochoose
+     */
+    ZeroCopyFileBlockReader(const FileDescriptorPtr& file,
+                const FileSlicesScheme& fileSlicesScheme,
+                const SizeBytes chunkSizeBytes = 0);
+
+private:
+    FileDescriptorPtr m_file;
+
+    tools::AlignedBuffer m_chunkBuffer;
+    size_t m_chunkBlocksCount = 1;              ///< blocks per single read
+    size_t m_loadedFirstBlockIndex = 0;
+    size_t m_loadedBlocksCount = 0;
+
+    std::string_view doReadBlocks(size_t firstBlockIndex, size_t count) override;
+    void loadChunk(size_t firstBlockIndex, size_t count);
+};
+
+
+} // ns ss
+
+
+#endif // SS_READERS_ZERO_COPY_READER_H
@@ -1,64 +1,83 @@
 #include "abstract_strategy.hpp"
 
 #include <cassert>
-#include <thread>
+
+#include <tools/log.hpp>
 
 #include "misc.hpp"
+#include "consts.hpp"
+#include "readers/io_uring.hpp"
 
 #include "strategies/sequental_strategy.hpp"
 #include "strategies/threaded_strategy.hpp"
+#include "strategies/pipeline_strategy.hpp"
+
+
+TS_LOGGER("strategy")
 
 
 void ss::AbstractHashStrategy::hash(const Configuration& config)
 {
     assert(config.hasherFactory.get() && "give me a haser factory");
     assert(config.readerfactory.get() && "give me a reader factory");
+    assert(config.memoryBudget.get() && "give me a memory budget");
     doHash(config);
 }
 
 
-std::string ss::AbstractHashStrategy::configurationStringRepresentation() const
+std::string ss::AbstractHashStrategy::configurationStringRepresentation(const Configuration& config) const
 {
-    return getConfigurationStringRepresentation();
+    ss::StrategySpec spec = getConfigurationSpec(config);
+    if (spec.isForced() && config.readerType != ss::ReaderType::Auto) {
+        spec.io = config.readerType;
+    }
+    return spec.toString();
 }
 
 
-std::string ss::AbstractHashStrategy::getConfigurationStringRepresentation() const
+ss::StrategySpec ss::AbstractHashStrategy::getConfigurationSpec(const Configuration&) const
 {
-    return std::string();
+    return ss::StrategySpec();
 }
 
 
 ss::HashStrategyPtr ss::AbstractHashStrategy::chooseStrategy(
         const std::string& filePath,
         ss::FileSlicesScheme& slices,
-        const std::string& forcedStrategySymbol)
+        const ss::StrategySpec& forcedStrategy,
+        ss::ReaderType& readerType,
+        const ss::DeviceProfile* deviceProfile)
 {
     const ss::MediaType mediaType = misc::guessFileMediaType(filePath);
+    readerType = chooseReaderType(mediaType, slices, readerType, deviceProfile);
 
     if (slices.suggestedReadBufferSizeBytes == 0) {
         slices.suggestedReadBufferSizeBytes = std::min(
                     slices.fileSizeBytes,
-                    misc::suggestReadBufferSizeByMediaType(mediaType, slices.blockSizeBytes));
+                    misc::suggestReadBufferSizeByMediaType(mediaType, slices.blockSizeBytes, deviceProfile));
     }
 
-    if (!forcedStrategySymbol.empty()) {
-        if (forcedStrategySymbol == "S") {
-            return std::make_shared<SequentalHashStrategy>();
-        }
-
-        if (forcedStrategySymbol[0] == 'T') {
-            const auto threadCountHint =
-                    forcedStrategySymbol.size() > 1
-                    ? std::stol(forcedStrategySymbol.substr(1, 1))
-                    : 0;
-            const auto seqRangeSize =
-                    forcedStrategySymbol.size() > 2
-                    ? misc::parseBlockSize(forcedStrategySymbol.substr(2))
-                    : 0;
-            slices.suggestedReadBufferSizeBytes = seqRangeSize;
-            return std::make_shared<ThreadedHashStrategy>(threadCountHint, seqRangeSize);
-        }
+    TS_DLOGF("profile: media: %s, reader: %s, read buffer: %lld, calibrated: %d",
+             misc::mediaTypeName(mediaType),
+             misc::readerTypeName(readerType),
+             slices.suggestedReadBufferSizeBytes,
+             deviceProfile != nullptr ? 1 : 0);
+
+    switch (forcedStrategy.kind) {
+    case 'S':
+        return std::make_shared<SequentalHashStrategy>(forcedStrategy.depth);
+    case 'H':
+        return PipelineHashStrategy::createSingleStream(forcedStrategy.hashers, forcedStrategy.range, forcedStrategy.read);
+    case 'P':
+        return std::make_shared<PipelineHashStrategy>(
+                    forcedStrategy.readers > 0 ? forcedStrategy.readers : misc::suggestReaderThreadsCountByMediaType(mediaType),
+                    forcedStrategy.hashers,
+                    forcedStrategy.range,
+                    forcedStrategy.read);
+    case 'T':
+    case 'A':
+        slices.suggestedReadBufferSizeBytes = forcedStrategy.range;
+        return std::make_shared<ThreadedHashStrategy>(forcedStrategy.threads, forcedStrategy.range, forcedStrategy.kind == 'A');
     }
 
     if (slices.blockCount == 1) {
@@ -69,20 +88,79 @@ ss::HashStrategyPtr ss::AbstractHashStrategy::chooseStrategy(
         return std::make_shared<SequentalHashStrategy>();
     }
 
+    if (deviceProfile != nullptr) {
+        // calibrated device => start at tuned optimum: queued reads are done by threaded strategy,
+        // otherwise tuned count of read streams, hashing threads are independent
+        if (readerType == ss::ReaderType::Uring) {
+            return std::make_shared<ThreadedHashStrategy>();
+        }
+        return std::make_shared<PipelineHashStrategy>(deviceProfile->threadsCount);
+    }
+
     switch (mediaType) {
         case ss::MediaType::HDD:
-            // NOTE: simple perf tests on generic notbook show no diff in speed improvemend between SSD and HDD with inc thread count
-            // in both cased (SSD and HDD) speed grows with thread count grows. Need more tests
-            // TODO 0: assumption that HDD can not read in mult thread, but what if it's RAID or somehting like that? Rethink!
-            return std::make_shared<ThreadedHashStrategy>(std::thread::hardware_concurrency() / 2);
+            // NOTE: several read streams make heads seek between them => single sequental stream of large reads,
+            // hashing is done in parallel in memory
+            // TODO 0: what if it's RAID or somehting like that? Rethink!
+            return PipelineHashStrategy::createSingleStream();
         case ss::MediaType::Memory:
         case ss::MediaType::SSD:
         case ss::MediaType::NetworkDrive:
         case ss::MediaType::Unknown:
-            return std::make_shared<ThreadedHashStrategy>();
+            // NOTE: too many storage kinds to hand-tune => large files are tuned while running
+            return std::make_shared<ThreadedHashStrategy>(0, 0, slices.fileSizeBytes >= ss::kAdaptiveMinFileSizeBytes);
     }
 
     assert(false && "strategy not choosed");
 
     return std::make_shared<SequentalHashStrategy>();
 }
+
+
+ss::ReaderType ss::AbstractHashStrategy::chooseReaderType(
+        ss::MediaType mediaType,
+        const FileSlicesScheme &slices,
+        ss::ReaderType forcedReaderType,
+        const ss::DeviceProfile* deviceProfile)
+{
+    if (forcedReaderType == ss::ReaderType::Uring && !ss::IoUring::isSupported()) {
+        TS_WLOG("io_uring is not supported by kernel, fallback to pread reader");
+        return ss::ReaderType::Pread;
+    }
+
+    if (forcedReaderType != ss::ReaderType::Auto) {
+        return forcedReaderType;
+    }
+
+#ifdef _WIN32
+    (void)mediaType;
+    (void)slices;
+    (void)deviceProfile;
+    return ss::ReaderType::Stream;
+#else
+    if (deviceProfile != nullptr && deviceProfile->queueDepth > 1 && ss::IoUring::isSupported()) {
+        return ss::ReaderType::Uring;
+    }
+
+    const bool isLocalDrive = mediaType == ss::MediaType::SSD || mediaType == ss::MediaType::HDD;
+    if (isLocalDrive && slices.fileSizeBytes >= ss::kDirectIoMinFileSizeBytes) {
+        return ss::ReaderType::Direct;
+    }
+    return ss::ReaderType::ZeroCopy;
+#endif
+}
+
+
+size_t ss::AbstractHashStrategy::suggestHashBatchBlocksCount(
+        const FileSlicesScheme &slices,
+        const tools::hash::HasherFactoryPtr &hasherFactory,
+        SizeBytes maxBatchSizeBytes)
+{
+    // whole read buffer at once, but not less then hasher wants
+    const size_t blocksPerReadBuffer = slices.suggestedReadBufferSizeBytes / slices.blockSizeBytes;
+    const size_t maxBlocksByMemory = std::max<size_t>(
+                1, std::max<SizeBytes>(0, std::min(maxBatchSizeBytes, ss::kMaxHashBatchSizeBytes)) / slices.blockSizeBytes);
+    return std::max<size_t>(1, std::min(
+                                std::max(blocksPerReadBuffer, hasherFactory->batchSizeHint()),
+                                maxBlocksByMemory));
+}
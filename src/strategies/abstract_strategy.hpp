@@ -8,9 +8,13 @@
 
 #include <tools/hash/abstract_hasher.hpp>
 
+#include "consts.hpp"
 #include "slices_scheme.hpp"
 #include "writers/abstract_writer.hpp"
 #include "reader.hpp"
+#include "readers/file_descriptor.hpp"
+#include "memory_budget.hpp"
+#include "strategies/strategy_spec.hpp"
 
 
 namespace ss {
@@ -40,6 +44,26 @@ public:
         ss::FileBlockReaderFactoryPtr readerfactory;
         tools::hash::HasherFactoryPtr hasherFactory;
         ss::DigestWriterPtr writer;
+
+        /// resolved type of readers made by reader factory (or io_uring one if async reads are set)
+        ss::ReaderType readerType = ss::ReaderType::Auto;
+
+        /// buffers sizing is based on its limit, buffers are accounted in it
+        ss::MemoryBudgetPtr memoryBudget = std::make_shared<ss::MemoryBudget>(ss::kDefaultMemoryLimit);
+
+        /// asynchronous (io_uring) reads setup. Used by threaded strategy instead of readers if file is set
+        struct AsyncReads {
+            ss::FileDescriptorPtr file;
+            size_t queueDepth = 0;
+            size_t buffersCount = 0;    ///< 0 => autochoose
+        } asyncReads;
+
+        /// OS read-ahead hints setup. Used by threaded strategy if file is set
+        struct Prefetch {
+            ss::FileDescriptorPtr file;
+            size_t rangesAhead = 0;     ///< count of ranges to prefetch ahead of scheduled ones
+            bool dropBehind = false;    ///< drop hashed ranges from OS page cache
+        } prefetch;
     };
 
     /**
@@ -52,20 +76,45 @@ public:
     void hash(const Configuration& config);
 
     /**
-     * @brief short descriptive string of strategy configuration. Used in debug logging
+     * @brief resolved strategy configuration in forced strategy spec form (@see StrategySpec), all keys of strategy
+     * including I/O ones of given configuration => may be used as forced strategy. Used in debug logging
      */
-    std::string configurationStringRepresentation() const;
+    std::string configurationStringRepresentation(const Configuration& config) const;
 private:
     virtual void doHash(const Configuration& config) = 0;
-    virtual std::string getConfigurationStringRepresentation() const;
+    /// strategy keys of spec, io key is set by caller
+    virtual ss::StrategySpec getConfigurationSpec(const Configuration& config) const;
 public:
 
     /**
      * @brief default strategy chooser
+     * @param forcedStrategy - strategy to create if forced, otherwise it is choosed by media type and file size
+     * @param readerType - in: forced reader type or ReaderType::Auto, out: resolved reader type
+     * @param deviceProfile - tuned profile of file device if calibrated, preferred over hard-coded defaults
      */
     static ss::HashStrategyPtr chooseStrategy(const std::string& filePath,
             FileSlicesScheme &slices,
-            const std::string& forcedStrategySymobl);
+            const ss::StrategySpec& forcedStrategy,
+            ss::ReaderType& readerType,
+            const ss::DeviceProfile* deviceProfile = nullptr);
+
+    /**
+     * @brief default reader chooser. Huge files on local drives are read bypassing OS cache
+     * @param forcedReaderType - returned as is if not ReaderType::Auto
+     * @param deviceProfile - calibrated with queued reads => io_uring
+     */
+    static ss::ReaderType chooseReaderType(ss::MediaType mediaType,
+            const FileSlicesScheme &slices,
+            ss::ReaderType forcedReaderType,
+            const ss::DeviceProfile* deviceProfile = nullptr);
+
+    /**
+     * @brief count of sequental blocks to read and hash at once by single call
+     * @param maxBatchSizeBytes - memory limit of single batch
+     */
+    static size_t suggestHashBatchBlocksCount(const FileSlicesScheme &slices,
+            const tools::hash::HasherFactoryPtr& hasherFactory,
+            SizeBytes maxBatchSizeBytes = ss::kMaxHashBatchSizeBytes);
 };
 
 
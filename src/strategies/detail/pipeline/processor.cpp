@@ -0,0 +1,303 @@
+#include "processor.hpp"
+
+#include <thread>
+#include <algorithm>
+
+#include <tools/backoff.hpp>
+#include <tools/log.hpp>
+
+#include "consts.hpp"
+
+
+TS_LOGGER("hash.pipeline")
+
+
+namespace {
+
+
+/// max digests queue length per hasher: how far hashers may run ahead of writer
+constexpr const size_t kDigestsQueueRangesCount = 16;
+
+
+} // ns anonymous
+
+
+ss::detail::pipeline::PipelineHashProcessor::PipelineHashProcessor(const ss::AbstractHashStrategy::Configuration &config,
+        size_t readerThreadsCount,
+        size_t hasherThreadsCount,
+        ss::SizeBytes rangeSizeBytes,
+        ss::SizeBytes readSizeBytes)
+    : m_config(config)
+{
+    const ss::SizeBytes blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+    const size_t blockCount = m_config.fileSlicesScheme.blockCount;
+    m_blocksPerRange = std::max<size_t>(1, rangeSizeBytes / blockSizeBytes);
+
+    m_rangesPerChunk = std::max<size_t>(1, readSizeBytes / (m_blocksPerRange * blockSizeBytes));
+    m_readerThreadsCount = std::max<size_t>(1, readerThreadsCount);
+    const size_t hintedHashersCount = std::max<size_t>(1, hasherThreadsCount);
+
+    // digests queues (+ ranges in hasher and writer hands) are preallocated upper bound, up to quarter of budget
+    const ss::SizeBytes memoryLimitBytes = m_config.memoryBudget->limit();
+    const auto rangeDigestsMemoryConsume = [&]() -> ss::SizeBytes {
+        return sizeof(RangeDigests) + ss::kHeapBlockOverheadBytes
+                + sizeof(tools::hash::Digest) * std::min(m_blocksPerRange, blockCount);
+    };
+    const auto digestsQueueRangesCount = [&](size_t hashersCount) -> size_t {
+        const ss::SizeBytes rangesCountByMemory = memoryLimitBytes / 4 / (rangeDigestsMemoryConsume() * static_cast<ss::SizeBytes>(hashersCount)) - 2;
+        return std::max<size_t>(1, std::min<ss::SizeBytes>(kDigestsQueueRangesCount, std::max<ss::SizeBytes>(0, rangesCountByMemory)));
+    };
+    const auto digestsMemoryConsume = [&](size_t hashersCount) -> ss::SizeBytes {
+        return static_cast<ss::SizeBytes>((digestsQueueRangesCount(hashersCount) + 2) * hashersCount) * rangeDigestsMemoryConsume();
+    };
+    // slot buffer: whole chunk + reader own buffer
+    const auto slotMemoryConsume = [&]() -> ss::SizeBytes {
+        return m_rangesPerChunk * m_blocksPerRange * blockSizeBytes
+                + m_config.fileSlicesScheme.suggestedReadBufferSizeBytes
+                + 2 * ss::kHeapBlockOverheadBytes;
+    };
+
+    // each reader needs at least one slot: shrink chunk, then range
+    while (slotMemoryConsume() * static_cast<ss::SizeBytes>(m_readerThreadsCount) + digestsMemoryConsume(hintedHashersCount)
+           > memoryLimitBytes) {
+        if (m_rangesPerChunk > 1) {
+            m_rangesPerChunk /= 2;
+        } else if (m_blocksPerRange > 1) {
+            m_blocksPerRange /= 2;
+        } else {
+            break;
+        }
+    }
+
+    m_rangesCount = (blockCount + m_blocksPerRange - 1) / m_blocksPerRange;
+    m_hasherThreadsCount = std::max<size_t>(1, std::min(hasherThreadsCount, m_rangesCount));
+
+    m_digestsQueueRangesCount = digestsQueueRangesCount(m_hasherThreadsCount);
+    m_digestsLease = MemoryBudget::Lease(m_config.memoryBudget, digestsMemoryConsume(m_hasherThreadsCount));
+    const ss::SizeBytes slotsMemoryLimitBytes = memoryLimitBytes - m_digestsLease.bytes();
+
+    m_chunksCount = (m_rangesCount + m_rangesPerChunk - 1) / m_rangesPerChunk;
+    m_readerThreadsCount = std::max<size_t>(1, std::min(
+                {m_readerThreadsCount, m_chunksCount, static_cast<size_t>(slotsMemoryLimitBytes / slotMemoryConsume())}));
+
+    // enough filled ranges to feed all hashers while readers fill next ones, but not out of memory budget
+    const size_t rangesPerReaders = m_readerThreadsCount * m_rangesPerChunk;
+    const size_t slotsToFeedHashers = (2 * m_hasherThreadsCount + rangesPerReaders - 1) / rangesPerReaders;
+    const size_t maxSlotsByMemory = slotsMemoryLimitBytes / slotMemoryConsume() / m_readerThreadsCount;
+    m_slotsPerReader = std::max<size_t>(1, std::min(std::max<size_t>(2, slotsToFeedHashers), maxSlotsByMemory));
+
+    // all filled ranges of reader for single hasher must fit queue => push never waits for long
+    const size_t rangesPerHasherPerChunk = (m_rangesPerChunk + m_hasherThreadsCount - 1) / m_hasherThreadsCount;
+    const size_t filledRangesQueueSize = m_slotsPerReader * rangesPerHasherPerChunk;
+
+    for(size_t r = 0; r < m_readerThreadsCount; ++r) {
+        m_slots.emplace_back(new Slot[m_slotsPerReader]);
+        for(size_t h = 0; h < m_hasherThreadsCount; ++h) {
+            m_filledRanges.emplace_back(std::make_unique<FilledRangesQueue>(filledRangesQueueSize));
+        }
+    }
+    for(size_t h = 0; h < m_hasherThreadsCount; ++h) {
+        m_digests.emplace_back(std::make_unique<DigestsQueue>(m_digestsQueueRangesCount));
+    }
+
+    TS_D2LOGF("init: blocks: %d", m_config.fileSlicesScheme.blockCount);
+    TS_D2LOGF("init: ranges: %d", m_rangesCount);
+    TS_D2LOGF("init: blocks per range: %d", m_blocksPerRange);
+    TS_D2LOGF("init: ranges per read: %d", m_rangesPerChunk);
+    TS_D2LOGF("init: reader threads: %d", m_readerThreadsCount);
+    TS_D2LOGF("init: hasher threads: %d", m_hasherThreadsCount);
+    TS_D2LOGF("init: slots per reader: %d", m_slotsPerReader);
+    TS_D2LOGF("init: digests queue ranges: %d", m_digestsQueueRangesCount);
+}
+
+
+ss::detail::pipeline::PipelineHashProcessor::~PipelineHashProcessor() = default;
+
+
+void ss::detail::pipeline::PipelineHashProcessor::run(const ss::DigestWriterPtr &writer)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(m_readerThreadsCount + m_hasherThreadsCount);
+
+    for(size_t r = 0; r < m_readerThreadsCount; ++r) {
+        threads.emplace_back([this, r]() {
+            readerWorker(r);
+        });
+    }
+    for(size_t h = 0; h < m_hasherThreadsCount; ++h) {
+        threads.emplace_back([this, h]() {
+            hasherWorker(h);
+        });
+    }
+
+    writerWorker(writer);
+
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+
+ss::detail::pipeline::PipelineHashProcessor::FilledRangesQueue &ss::detail::pipeline::PipelineHashProcessor::filledRangesQueue(size_t readerIndex, size_t hasherIndex)
+{
+    return *m_filledRanges[readerIndex * m_hasherThreadsCount + hasherIndex];
+}
+
+
+size_t ss::detail::pipeline::PipelineHashProcessor::rangeReaderIndex(size_t rangeIndex) const
+{
+    return (rangeIndex / m_rangesPerChunk) % m_readerThreadsCount;
+}
+
+
+void ss::detail::pipeline::PipelineHashProcessor::readerWorker(size_t readerIndex)
+{
+    try {
+        const size_t blockCount = m_config.fileSlicesScheme.blockCount;
+        const size_t blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+        Slot* slots = m_slots[readerIndex].get();
+        tools::Backoff backoff;
+
+        for(size_t c = readerIndex, j = 0; c < m_chunksCount; c += m_readerThreadsCount, ++j) {
+            Slot& slot = slots[j % m_slotsPerReader];
+            if (!slot.reader) {
+                slot.reader = m_config.readerfactory->create();
+            }
+
+            // wait till all ranges of slot's previous chunk are hashed
+            backoff.reset();
+            while (slot.pendingRangesCount.load(std::memory_order_acquire) > 0) {
+                if (m_isFailed) {
+                    return;
+                }
+                backoff.pause();
+            }
+
+            const size_t firstRangeIndex = c * m_rangesPerChunk;
+            const size_t endRangeIndex = std::min(firstRangeIndex + m_rangesPerChunk, m_rangesCount);
+            const size_t firstBlockIndex = firstRangeIndex * m_blocksPerRange;
+            const size_t chunkBlocksCount = std::min(m_rangesPerChunk * m_blocksPerRange, blockCount - firstBlockIndex);
+
+            const auto data = slot.reader->readBlocks(firstBlockIndex, chunkBlocksCount);
+            slot.pendingRangesCount.store(endRangeIndex - firstRangeIndex, std::memory_order_relaxed);
+
+            TS_D3LOGF("reader %d: chunk %d", readerIndex, c);
+
+            // fan out chunk ranges to hashers
+            for(size_t k = firstRangeIndex; k < endRangeIndex; ++k) {
+                FilledRange range;
+                range.rangeIndex = k;
+                const size_t rangeFirstBlockIndex = k * m_blocksPerRange;
+                range.count = std::min(m_blocksPerRange, blockCount - rangeFirstBlockIndex);
+                range.data = data.substr((rangeFirstBlockIndex - firstBlockIndex) * blockSizeBytes, range.count * blockSizeBytes);
+                range.slot = &slot;
+
+                auto& queue = filledRangesQueue(readerIndex, k % m_hasherThreadsCount);
+                backoff.reset();
+                while (!queue.tryPush(range)) {
+                    if (m_isFailed) {
+                        return;
+                    }
+                    backoff.pause();
+                }
+            }
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+}
+
+
+void ss::detail::pipeline::PipelineHashProcessor::hasherWorker(size_t hasherIndex)
+{
+    try {
+        const size_t blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+        auto hasher = m_config.hasherFactory->create();
+        std::vector<std::string_view> blocks(m_blocksPerRange);
+        tools::Backoff backoff;
+
+        for(size_t k = hasherIndex; k < m_rangesCount; k += m_hasherThreadsCount) {
+            auto& queue = filledRangesQueue(rangeReaderIndex(k), hasherIndex);
+
+            FilledRange range;
+            backoff.reset();
+            while (!queue.tryPop(range)) {
+                if (m_isFailed) {
+                    return;
+                }
+                backoff.pause();
+            }
+
+            for(size_t i = 0; i < range.count; ++i) {
+                blocks[i] = range.data.substr(i * blockSizeBytes, blockSizeBytes);
+            }
+
+            RangeDigests result;
+            result.rangeIndex = k;
+            result.digests.resize(range.count);
+            hasher->hashMany(blocks.data(), range.count, result.digests.data());
+
+            range.slot->pendingRangesCount.fetch_sub(1, std::memory_order_release);
+
+            TS_D3LOGF("hasher %d: range %d", hasherIndex, k);
+
+            backoff.reset();
+            while (!m_digests[hasherIndex]->tryPush(result)) {
+                if (m_isFailed) {
+                    return;
+                }
+                backoff.pause();
+            }
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+}
+
+
+void ss::detail::pipeline::PipelineHashProcessor::writerWorker(const ss::DigestWriterPtr &writer)
+{
+    try {
+        tools::Backoff backoff;
+        RangeDigests result;
+
+        for(size_t k = 0; k < m_rangesCount; ++k) {
+            auto& queue = *m_digests[k % m_hasherThreadsCount];
+
+            backoff.reset();
+            while (!queue.tryPop(result)) {
+                if (m_isFailed) {
+                    return;
+                }
+                backoff.pause();
+            }
+
+            if (writer) {
+                writer->write(result.digests.data(), result.digests.size());
+                if (writer->isStopRequested()) {
+                    // other workers leave by failure flag, but without error
+                    m_isFailed = true;
+                    return;
+                }
+            }
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+}
+
+
+void ss::detail::pipeline::PipelineHashProcessor::fail(std::exception_ptr error)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutError);
+        if (!m_error) {
+            m_error = error;
+        }
+    }
+    m_isFailed = true;
+}
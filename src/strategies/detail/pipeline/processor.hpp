@@ -0,0 +1,110 @@
+#ifndef SS_STRATEGIES_PIPELINE_PROCESSOR_H
+#define SS_STRATEGIES_PIPELINE_PROCESSOR_H
+#pragma once
+
+#include "reader.hpp"
+#include "writers/abstract_writer.hpp"
+#include "strategies/abstract_strategy.hpp"
+
+#include <tools/hash/abstract_hasher.hpp>
+#include <tools/spsc_queue.hpp>
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <exception>
+
+
+namespace ss {
+namespace detail {
+namespace pipeline {
+
+
+/**
+ * @brief Reader/hasher pipeline: R reader threads read chunks into own buffers (slots) and fan out
+ * chunk ranges to H hasher threads by SPSC queues, hashers pass digests to writer (caller thread)
+ * by SPSC queues. Chunk c is read by reader c % R, range k is hashed by hasher k % H => each queue
+ * has single producer and consumer, all queues are FIFO and ordered by k => no reordering buffers needed
+ */
+struct PipelineHashProcessor {
+public:
+
+    /**
+     * @param config - config from strategy (factories, slice scheme etc)
+     * @param readerThreadsCount - count of reading threads (concurrent I/O streams)
+     * @param hasherThreadsCount - count of hashing threads
+     * @param rangeSizeBytes - size of range hashed by single hasher at once
+     * @param readSizeBytes - size of single read (chunk), >= range size. 0 => range size
+     */
+    PipelineHashProcessor(const ss::AbstractHashStrategy::Configuration& config,
+            size_t readerThreadsCount,
+            size_t hasherThreadsCount,
+            ss::SizeBytes rangeSizeBytes,
+            ss::SizeBytes readSizeBytes = 0);
+    ~PipelineHashProcessor();
+
+    /**
+     * @brief main runner
+     */
+    void run(const ss::DigestWriterPtr &writer);
+
+private:
+
+    /// chunk buffer of reader thread
+    struct alignas(tools::kCacheLineSize) Slot {
+        ss::FileBlockReaderPtr reader;
+        std::atomic_size_t pendingRangesCount = 0;  ///< filled and not hashed yet ranges
+    };
+
+    struct FilledRange {
+        size_t rangeIndex = 0;
+        size_t count = 0;
+        std::string_view data;
+        Slot* slot = nullptr;
+    };
+
+    struct RangeDigests {
+        size_t rangeIndex = 0;
+        std::vector<tools::hash::Digest> digests;
+    };
+
+    using FilledRangesQueue = tools::SpscQueue<FilledRange>;
+    using DigestsQueue = tools::SpscQueue<RangeDigests>;
+
+    ss::AbstractHashStrategy::Configuration m_config;
+
+    size_t m_readerThreadsCount = 1;
+    size_t m_hasherThreadsCount = 1;
+    size_t m_blocksPerRange = 1;
+    size_t m_rangesCount = 0;
+    size_t m_rangesPerChunk = 1;
+    size_t m_chunksCount = 0;
+    size_t m_slotsPerReader = 1;
+    size_t m_digestsQueueRangesCount = 1;
+
+    std::vector<std::unique_ptr<Slot[]>> m_slots;                       ///< [reader][slot]
+    std::vector<std::unique_ptr<FilledRangesQueue>> m_filledRanges;     ///< [reader * H + hasher]
+    std::vector<std::unique_ptr<DigestsQueue>> m_digests;               ///< [hasher]
+    MemoryBudget::Lease m_digestsLease;
+
+    // failure handling, stop requested by writer too
+    std::atomic_bool m_isFailed = false;
+    std::mutex m_mutError;
+    std::exception_ptr m_error;
+
+    FilledRangesQueue& filledRangesQueue(size_t readerIndex, size_t hasherIndex);
+    size_t rangeReaderIndex(size_t rangeIndex) const;
+
+    void readerWorker(size_t readerIndex);
+    void hasherWorker(size_t hasherIndex);
+    void writerWorker(const ss::DigestWriterPtr &writer);
+
+    void fail(std::exception_ptr error);
+};
+
+
+}}} // ns ss::detail::pipeline
+
+
+#endif // SS_STRATEGIES_PIPELINE_PROCESSOR_H
@@ -0,0 +1,178 @@
+#include "adaptive_tuner.hpp"
+
+#include <algorithm>
+
+#include <tools/log.hpp>
+
+
+TS_LOGGER("hash.threaded.tuner")
+
+
+namespace {
+
+
+/// measure window: short enough to converge in seconds, long enough to smooth jobs granularity
+constexpr const auto kWindowDuration = std::chrono::milliseconds(250);
+
+/// relative throughput grow to accept step (noise filter)
+constexpr const double kMinImprovement = 1.03;
+
+/// 2 parameters * 2 directions
+constexpr const size_t kProbesToConverge = 4;
+
+/// converged setup is re-probed after this count of windows (storage load may change)
+constexpr const size_t kConvergedWindowsToReprobe = 20;
+
+
+} // ns anonymous
+
+
+ss::detail::threaded::AdaptiveTuner::AdaptiveTuner(const Setup &initial, const Setup &min, const Setup &max)
+    : m_min(min)
+    , m_max(max)
+    , m_setup(initial)
+    , m_bestSetup(initial)
+{
+}
+
+
+bool ss::detail::threaded::AdaptiveTuner::update(ss::SizeBytes processedBytes, Clock::time_point now)
+{
+    if (!m_isStarted) {
+        m_isStarted = true;
+        m_windowStart = now;
+        m_windowStartBytes = processedBytes;
+        return false;
+    }
+
+    const auto windowDuration = now - m_windowStart;
+    if (windowDuration < kWindowDuration) {
+        return false;
+    }
+
+    const double seconds = std::chrono::duration<double>(windowDuration).count();
+    const double throughput = (processedBytes - m_windowStartBytes) / seconds;
+    m_windowStart = now;
+    m_windowStartBytes = processedBytes;
+
+    const Setup previousSetup = m_setup;
+    onWindowMeasured(throughput);
+
+    return m_setup.workersCount != previousSetup.workersCount
+            || m_setup.blocksPerJob != previousSetup.blocksPerJob;
+}
+
+
+void ss::detail::threaded::AdaptiveTuner::onWindowMeasured(double throughput)
+{
+    TS_DLOGF("window: workers: %d, blocks per job: %d, throughput: %.1f MB/s",
+             m_setup.workersCount, m_setup.blocksPerJob, throughput / (1024 * 1024));
+
+    if (isConverged()) {
+        // track current throughput level, re-probe from time to time
+        m_bestThroughput = throughput;
+        if (++m_convergedWindowsCount < kConvergedWindowsToReprobe) {
+            return;
+        }
+        m_convergedWindowsCount = 0;
+        m_failedProbesCount = 0;
+        probeNextStep();
+        return;
+    }
+
+    const bool isBaseline = m_bestThroughput == 0.0;
+    if (isBaseline || throughput > m_bestThroughput * kMinImprovement) {
+        // step accepted (or baseline measured) => continue same way
+        if (!isBaseline) {
+            m_failedProbesCount = 0;
+        }
+        m_bestThroughput = throughput;
+        m_bestSetup = m_setup;
+    } else {
+        // step failed => revert, try other direction, then other parameter
+        m_setup = m_bestSetup;
+        ++m_failedProbesCount;
+        if (m_direction > 0) {
+            m_direction = -1;
+        } else {
+            m_direction = 1;
+            m_parameter = m_parameter == Parameter::Workers ? Parameter::RangeSize : Parameter::Workers;
+        }
+
+        if (isConverged()) {
+            TS_DLOGF("converged: workers: %d, blocks per job: %d", m_setup.workersCount, m_setup.blocksPerJob);
+            return;
+        }
+    }
+
+    probeNextStep();
+}
+
+
+const ss::detail::threaded::AdaptiveTuner::Setup &ss::detail::threaded::AdaptiveTuner::setup() const
+{
+    return m_setup;
+}
+
+
+bool ss::detail::threaded::AdaptiveTuner::isConverged() const
+{
+    return m_failedProbesCount >= kProbesToConverge;
+}
+
+
+bool ss::detail::threaded::AdaptiveTuner::probeNextStep()
+{
+    // step is out of bounds => count as failed probe
+    for(size_t i = 0; i < kProbesToConverge; ++i) {
+        Setup probe = m_bestSetup;
+        if (applyStep(probe)) {
+            m_setup = probe;
+            return true;
+        }
+
+        ++m_failedProbesCount;
+        if (m_direction > 0) {
+            m_direction = -1;
+        } else {
+            m_direction = 1;
+            m_parameter = m_parameter == Parameter::Workers ? Parameter::RangeSize : Parameter::Workers;
+        }
+        if (isConverged()) {
+            break;
+        }
+    }
+
+    m_setup = m_bestSetup;
+    return false;
+}
+
+
+bool ss::detail::threaded::AdaptiveTuner::applyStep(Setup &setup) const
+{
+    switch (m_parameter) {
+    case Parameter::Workers: {
+        // ~25% step, at least 1 worker
+        const size_t step = std::max<size_t>(1, setup.workersCount / 4);
+        const size_t workersCount = m_direction > 0
+                ? std::min(setup.workersCount + step, m_max.workersCount)
+                : std::max(setup.workersCount > step ? setup.workersCount - step : 0, m_min.workersCount);
+        if (workersCount == setup.workersCount) {
+            return false;
+        }
+        setup.workersCount = workersCount;
+        return true;
+    }
+    case Parameter::RangeSize: {
+        const size_t blocksPerJob = m_direction > 0
+                ? std::min(setup.blocksPerJob * 2, m_max.blocksPerJob)
+                : std::max(setup.blocksPerJob / 2, m_min.blocksPerJob);
+        if (blocksPerJob == setup.blocksPerJob) {
+            return false;
+        }
+        setup.blocksPerJob = blocksPerJob;
+        return true;
+    }
+    }
+    return false;
+}
@@ -0,0 +1,81 @@
+#ifndef SS_STRATEGIES_THREADED_ADAPTIVE_TUNER_H
+#define SS_STRATEGIES_THREADED_ADAPTIVE_TUNER_H
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "types.hpp"
+
+
+namespace ss {
+namespace detail {
+namespace threaded {
+
+
+/**
+ * @brief Online hill-climbing tuner of threaded processing setup (active workers count, job range size).
+ * Throughput is measured over short windows, each window probes one step of one parameter:
+ * step is kept if throughput grows, otherwise reverted and next direction/parameter is probed.
+ * When no step helps - setup is considered converged and is re-probed from time to time
+ * MT: not thread-safe, used by producer thread only
+ */
+class AdaptiveTuner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Setup {
+        size_t workersCount = 1;
+        size_t blocksPerJob = 1;
+    };
+
+    /**
+     * @param initial - starting setup
+     * @param min - lower bounds
+     * @param max - upper bounds
+     */
+    AdaptiveTuner(const Setup& initial, const Setup& min, const Setup& max);
+
+    /**
+     * @brief feed progress, probe next step if measure window is over
+     * @param processedBytes - total count of processed bytes from start
+     * @return true if setup changed
+     */
+    bool update(ss::SizeBytes processedBytes, Clock::time_point now = Clock::now());
+
+    const Setup& setup() const;
+
+    bool isConverged() const;
+
+private:
+    enum class Parameter {
+        Workers,
+        RangeSize,
+    };
+
+    const Setup m_min;
+    const Setup m_max;
+
+    Setup m_setup;          ///< current (probed)
+    Setup m_bestSetup;      ///< best known
+    double m_bestThroughput = 0.0;
+
+    Parameter m_parameter = Parameter::Workers;
+    int m_direction = 1;
+    size_t m_failedProbesCount = 0;     ///< in row, all directions of all parameters failed => converged
+    size_t m_convergedWindowsCount = 0;
+
+    Clock::time_point m_windowStart;
+    ss::SizeBytes m_windowStartBytes = 0;
+    bool m_isStarted = false;
+
+    void onWindowMeasured(double throughput);
+    bool probeNextStep();
+    bool applyStep(Setup& setup) const;
+};
+
+
+}}} // ns ss::detail::threaded
+
+
+#endif // SS_STRATEGIES_THREADED_ADAPTIVE_TUNER_H
@@ -0,0 +1,42 @@
+#include "hasher_job.hpp"
+
+#include <tools/log.hpp>
+
+
+TS_LOGGER("hash.threaded.hasher_job")
+
+
+ss::detail::threaded::HasherJob::HasherJob(size_t jobIndex, const UringRangesReader::Range &range, UringRangesReader *reader, ThreadedHashProcessor *ctx)
+    : m_jobIndex(jobIndex)
+    , m_range(range)
+    , m_reader(reader)
+    , m_ctx(ctx)
+{
+}
+
+
+void ss::detail::threaded::HasherJob::doRun()
+{
+    try {
+        execute(m_ctx->workerBlockReaderHasher());
+    } catch (const std::exception& e) {
+        TS_ELOGF("hash job failed [%d]: %s", m_range.firstBlockIndex, e.what());
+        std::abort();
+    } catch (...) {
+        TS_ELOGF("hash job failed [%d]: unkown", m_range.firstBlockIndex);
+        std::abort();
+    }
+}
+
+
+void ss::detail::threaded::HasherJob::execute(const BlockReaderAndHasherPtr &blockReaderHasher)
+{
+    auto& digests = m_ctx->jobResultDigests(m_jobIndex, *blockReaderHasher);
+    digests.resize(m_range.count);
+
+    blockReaderHasher->calculateHashes(m_range.data, digests.size(), digests.data());
+    m_ctx->storeJobResults(m_range.firstBlockIndex, digests);
+    m_reader->releaseBuffer(m_range.bufferIndex);
+
+    m_ctx->publicateFinishedJobResults(m_jobIndex, digests.size());
+}
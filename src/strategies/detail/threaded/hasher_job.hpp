@@ -0,0 +1,41 @@
+#ifndef SS_STRATEGIES_THREADED_HASHER_JOB_H
+#define SS_STRATEGIES_THREADED_HASHER_JOB_H
+#pragma once
+
+#include <tools/thread_pool.hpp>
+#include "strategies/detail/threaded/processor.hpp"
+#include "readers/uring_reader.hpp"
+
+
+namespace ss {
+namespace detail {
+namespace threaded {
+
+/**
+ * @brief hash job for already read range (@see UringRangesReader), range buffer is released after hashing
+ */
+class HasherJob : public tools::ThreadPool::IJob {
+public:
+    /**
+     * @param jobIndex - sequence number of job, results are stored to its slot
+     */
+    HasherJob(size_t jobIndex, const UringRangesReader::Range& range, UringRangesReader* reader, ThreadedHashProcessor* ctx);
+
+protected:
+
+    void doRun() override;
+
+private:
+    size_t m_jobIndex = 0;
+    UringRangesReader::Range m_range;
+    UringRangesReader* m_reader = nullptr;
+    ThreadedHashProcessor* m_ctx = nullptr;
+
+    void execute(const BlockReaderAndHasherPtr& blockReaderHasher);
+};
+
+
+}}} // ns ss::detail::threaded
+
+
+#endif // SS_STRATEGIES_THREADED_HASHER_JOB_H
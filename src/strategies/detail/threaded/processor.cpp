@@ -1,97 +1,206 @@
 #include "processor.hpp"
 
 #include <thread>
+#include <future>
+#include <functional>
+#include <cassert>
+#include <tools/backoff.hpp>
 #include <tools/log.hpp>
 
 #include "consts.hpp"
 #include "strategies/detail/threaded/reader_and_hasher_job.hpp"
+#include "strategies/detail/threaded/hasher_job.hpp"
 
 
 TS_LOGGER("hash.threaded.ctx")
 
 
+namespace {
+
+/// results ring: writer lag of more jobs gives nothing but memory consumption
+constexpr const size_t kMaxResultSlotsCount = 4096;
+
+
+/// pool job of given function
+class FunctionJob : public tools::ThreadPool::IJob {
+public:
+    explicit FunctionJob(std::function<void()>&& function)
+        : m_function(std::move(function))
+    {
+    }
+
+protected:
+    void doRun() override
+    {
+        m_function();
+    }
+
+private:
+    std::function<void()> m_function;
+};
+
+} // ns anonymous
+
+
 ss::detail::threaded::ThreadedHashProcessor::ThreadedHashProcessor(const ss::AbstractHashStrategy::Configuration& config,
         size_t threadPoolSizeHint,
-        SizeBytes singleThreadSequentalRangeSizeBytes)
+        SizeBytes singleThreadSequentalRangeSizeBytes,
+        bool isAdaptive)
     : m_config(config)
+    , m_isPositionalOutput(config.writer && config.writer->isPositional())
 {
-    const auto effThreadPoolSizeHint = std::min(m_config.fileSlicesScheme.blockCount, threadPoolSizeHint);
-    m_threadPool = std::make_unique<tools::ThreadPool>(effThreadPoolSizeHint);
+    // async reads are paced by reads queue, not by jobs => nothing to tune
+    isAdaptive = isAdaptive && !m_config.asyncReads.file;
+
+    const size_t blockCount = m_config.fileSlicesScheme.blockCount;
+    const ss::SizeBytes blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+    const ss::SizeBytes memoryLimitBytes = m_config.memoryBudget->limit();
+    size_t initialThreadsCount = std::max<size_t>(1, std::min(blockCount, threadPoolSizeHint));
+    size_t initialBlocksPerJob = std::max<size_t>(1, singleThreadSequentalRangeSizeBytes / blockSizeBytes);
+
+    // job range is held by reader of worker (synchronous reads) or by read buffer (asynchronous reads)
+    while (initialBlocksPerJob > 1 && workerMemoryConsume(initialBlocksPerJob) > memoryLimitBytes / 2) {
+        initialBlocksPerJob /= 2;
+    }
 
-    m_threadPoolSize = m_threadPool->size();
-    m_readersJobsContexts.reserve(m_threadPoolSize);
-    m_blocksPerThread = std::max<size_t>(
-                1,
-                singleThreadSequentalRangeSizeBytes / m_config.fileSlicesScheme.blockSizeBytes);
+    // synchronous reads: each worker holds reader buffers of job range => all workers must fit memory budget
+    size_t maxThreadsCount = initialThreadsCount * (isAdaptive ? ss::kAdaptiveMaxThreadsFactor : 1);
+    if (!m_config.asyncReads.file) {
+        const size_t threadsCountByMemory = std::max<size_t>(1, memoryLimitBytes / workerMemoryConsume(initialBlocksPerJob));
+        initialThreadsCount = std::min(initialThreadsCount, threadsCountByMemory);
+        maxThreadsCount = std::min(maxThreadsCount, threadsCountByMemory);
+    }
 
-    const size_t maxResultsStoreCount = estimateMaxResultStoreCountLimit();
-    m_maxResultVectorStoreCount = maxResultsStoreCount / m_blocksPerThread;
+    // adaptive: pool is prepared for max setup, only part of it is active
+    m_threadPoolSize = std::max<size_t>(1, std::min(blockCount, maxThreadsCount));
+    m_blocksPerThread = initialBlocksPerJob;
+
+    if (isAdaptive) {
+        // job buffers of all threads must fit memory budget
+        size_t maxBlocksPerJob = initialBlocksPerJob * ss::kAdaptiveMaxRangeSizeFactor;
+        while (maxBlocksPerJob > initialBlocksPerJob
+               && workerMemoryConsume(maxBlocksPerJob) * static_cast<ss::SizeBytes>(m_threadPoolSize) > memoryLimitBytes) {
+            maxBlocksPerJob = std::max(initialBlocksPerJob, maxBlocksPerJob / 2);
+        }
+        m_blocksPerThread = maxBlocksPerJob;
+    }
+
+    m_blocksPerJob = initialBlocksPerJob;
+    m_activeThreadsLimit = std::min(initialThreadsCount, m_threadPoolSize);
+
+    const size_t minBlocksPerJob = isAdaptive
+            ? std::max<size_t>(1, initialBlocksPerJob / ss::kAdaptiveMaxRangeSizeFactor)
+            : initialBlocksPerJob;
+
+    if (isAdaptive) {
+        m_tuner = std::make_unique<AdaptiveTuner>(
+                    AdaptiveTuner::Setup{m_activeThreadsLimit, m_blocksPerJob},
+                    AdaptiveTuner::Setup{1, minBlocksPerJob},
+                    AdaptiveTuner::Setup{m_threadPoolSize, m_blocksPerThread});
+    }
+
+    if (m_config.asyncReads.file) {
+        // by default twice of queue depth - to keep queue full while hashing, but not out of memory budget
+        const ss::SizeBytes rangeBufferMemoryConsume = m_blocksPerThread * blockSizeBytes + ss::kHeapBlockOverheadBytes
+                + 2 * resultSlotMemoryConsume(m_blocksPerThread);
+        const size_t maxBuffersCount = std::max<size_t>(1, memoryLimitBytes / rangeBufferMemoryConsume);
+        m_asyncReadBuffersCount = m_config.asyncReads.buffersCount > 0
+                ? m_config.asyncReads.buffersCount
+                : 2 * m_config.asyncReads.queueDepth;
+        m_asyncReadBuffersCount = std::max<size_t>(1, std::min(m_asyncReadBuffersCount, maxBuffersCount));
+
+        // threads count is not limited by memory here, but each thread needs results slots:
+        // shrink ranges (slots are sized by them too), then buffers count until minimal setup fits budget
+        while (asyncReadsMemoryConsume(m_blocksPerThread, m_asyncReadBuffersCount) > memoryLimitBytes) {
+            if (m_blocksPerThread > 1) {
+                m_blocksPerThread /= 2;
+            } else if (m_asyncReadBuffersCount > 1) {
+                --m_asyncReadBuffersCount;
+            } else {
+                break;
+            }
+        }
+        m_blocksPerJob = std::min(m_blocksPerJob, m_blocksPerThread);
+    }
+
+    // slots digests storages are allocated once, for max job range
+    const size_t maxJobsCount = (blockCount + std::min(minBlocksPerJob, m_blocksPerThread) - 1)
+            / std::min(minBlocksPerJob, m_blocksPerThread);
+    m_resultSlotsCount = m_isPositionalOutput ? 0 : estimateResultSlotsCountLimit(maxJobsCount);
+    m_resultSlotsLease = MemoryBudget::Lease(m_config.memoryBudget, m_resultSlotsCount * resultSlotMemoryConsume(m_blocksPerThread));
+    m_resultSlots = std::make_unique<ResultSlot[]>(m_resultSlotsCount);
+    for(size_t i = 0; i < m_resultSlotsCount; ++i) {
+        m_resultSlots[i].digests.reserve(std::min(m_blocksPerThread, blockCount));
+    }
 
     TS_D2LOGF("init: blocks: %d", m_config.fileSlicesScheme.blockCount);
     TS_D2LOGF("init: block size: %d", m_config.fileSlicesScheme.blockSizeBytes);
     TS_D2LOGF("init: threads: %d", m_threadPoolSize);
     TS_D2LOGF("init: blocks per thread: %d", m_blocksPerThread);
-    TS_D2LOGF("init: max storable resutls: %d", maxResultsStoreCount);
-    TS_D2LOGF("init: max storable resutls blobs: %d", m_maxResultVectorStoreCount);
+    TS_D2LOGF("init: result slots: %d", m_resultSlotsCount);
+    TS_D2LOGF("init: async read buffers: %d", m_asyncReadBuffersCount);
+    TS_D2LOGF("init: adaptive: %d", m_tuner ? 1 : 0);
+    TS_D2LOGF("init: positional output: %d", m_isPositionalOutput ? 1 : 0);
 }
 
 
-ss::detail::threaded::BlockReaderAndHasherPtr ss::detail::threaded::ThreadedHashProcessor::acquireBlockReaderHasher()
+const ss::detail::threaded::BlockReaderAndHasherPtr& ss::detail::threaded::ThreadedHashProcessor::workerBlockReaderHasher()
 {
-    std::lock_guard<std::mutex> guard(m_mutReadersJobsContexts);
+    return m_workers->workerBlockReaderHasher();
+}
 
-    if (m_availableReadersJobsContexts.empty()) {
-        auto res = std::make_shared<ss::detail::threaded::BlockReaderAndHasher>(
-                    m_config.readerfactory->create(),
-                    m_config.hasherFactory->create());
-        m_readersJobsContexts.push_back(res);
-        return res;
-    }
 
-    auto res = m_availableReadersJobsContexts.top();
-    m_availableReadersJobsContexts.pop();
-    return res;
+ss::detail::threaded::ThreadedHashProcessor::ResultSlot &ss::detail::threaded::ThreadedHashProcessor::resultSlot(size_t jobIndex)
+{
+    return m_resultSlots[jobIndex % m_resultSlotsCount];
 }
 
 
-void ss::detail::threaded::ThreadedHashProcessor::releaseBlockReaderHasher(const BlockReaderAndHasherPtr &ctx)
+std::vector<tools::hash::Digest> &ss::detail::threaded::ThreadedHashProcessor::jobResultDigests(size_t jobIndex, BlockReaderAndHasher &blockReaderHasher)
 {
-    std::lock_guard<std::mutex> guard(m_mutReadersJobsContexts);
-    m_availableReadersJobsContexts.push(ctx);
+    return m_isPositionalOutput
+            ? blockReaderHasher.digests
+            : resultSlot(jobIndex).digests;
 }
 
 
-void ss::detail::threaded::ThreadedHashProcessor::publicateFinishedJobResults(size_t startBlock, std::vector<tools::hash::Digest> &&digests)
+void ss::detail::threaded::ThreadedHashProcessor::storeJobResults(size_t firstBlockIndex, const std::vector<tools::hash::Digest> &digests)
 {
-    {
-        std::lock_guard<std::mutex> guard(m_mutDigestsResults);
-        TS_D3LOGF("worker: store res [%d+%d]", startBlock, digests.size());
-        m_digestsResults.emplace(startBlock, std::move(digests));
+    if (!m_isPositionalOutput) {
+        return;
     }
 
-    if (m_nextBlockIndexToWriteResultFor == startBlock) {
-        m_cvNextSequentalResultIsReady.notify_all();
-    }
+    TS_D3LOGF("worker: write res [%d-%d]", firstBlockIndex, digests.size());
+    m_config.writer->writeAt(firstBlockIndex, digests.data(), digests.size());
+}
 
-    {
-        m_runningHasherJobsCount--;
-        m_cvSomeReadAndHashJobFinished.notify_one();
+
+void ss::detail::threaded::ThreadedHashProcessor::publicateFinishedJobResults(size_t jobIndex, size_t blocksCount)
+{
+    TS_D3LOGF("worker: store res #%d [%d]", jobIndex, blocksCount);
+
+    m_hashedBlocksCount.fetch_add(blocksCount, std::memory_order_relaxed);
+    if (m_isPositionalOutput) {
+        // results are written already => count of written blocks, not prefix of them
+        m_nextBlockIndexToWriteResultFor.fetch_add(blocksCount, std::memory_order_release);
+    } else {
+        resultSlot(jobIndex).isReady.store(true, std::memory_order_release);
     }
+    m_runningHasherJobsCount.fetch_sub(1, std::memory_order_release);
 }
 
 
 void ss::detail::threaded::ThreadedHashProcessor::checkAndWaitOnLimits()
 {
-    std::unique_lock<std::mutex> guard(m_mutDigestsResults);
-
-    // to stop produce jobs due threads limit
-    if (m_runningHasherJobsCount >= m_threadPoolSize) {
-        m_cvSomeReadAndHashJobFinished.wait(guard);
-    }
-
-    // to stop produce jobs due memory limit
-    while (m_digestsResults.size() >= m_maxResultVectorStoreCount) {
-        m_cvNextSequentalResultIsReady.wait(guard);
+    tools::Backoff backoff;
+
+    // to stop produce jobs due threads limit (adaptive: limit may be lowered, so wait until fit)
+    // and due results ring space (memory limit). Stopped writer frees nothing => no wait
+    while ((m_runningHasherJobsCount.load(std::memory_order_acquire) >= m_activeThreadsLimit
+            || (!m_isPositionalOutput
+                && m_nextJobIndexToSchedule >= m_nextJobIndexToWrite.load(std::memory_order_acquire) + m_resultSlotsCount))
+           && !isStopRequested()) {
+        backoff.pause();
     }
 }
 
@@ -100,115 +209,309 @@ void ss::detail::threaded::ThreadedHashProcessor::scheduleNextReadAndHashJob()
 {
     const size_t startBlock = m_nextBlockIndexToScheduleReadAndHash;
     const size_t endBlock = std::min(
-                startBlock + m_blocksPerThread,
+                startBlock + m_blocksPerJob,
                 m_config.fileSlicesScheme.blockCount);
 
     m_nextBlockIndexToScheduleReadAndHash = endBlock;
 
+    const size_t jobIndex = m_nextJobIndexToSchedule++;
     m_runningHasherJobsCount++;
-    TS_D3LOGF("enqueue job [%d-%d]", startBlock, endBlock - startBlock);
+    TS_D3LOGF("enqueue job #%d [%d-%d]", jobIndex, startBlock, endBlock - startBlock);
 
-    m_threadPool->addJob(std::make_shared<ReaderAndHasherJob>(startBlock, endBlock, this));
+    m_workers->hashersPool().addJob(std::make_unique<ReaderAndHasherJob>(jobIndex, startBlock, endBlock, this));
+
+    prefetchAhead();
+    dropBehindConsumers();
 }
 
 
-bool ss::detail::threaded::ThreadedHashProcessor::isAllResultsDoneAndFlushed() const
+void ss::detail::threaded::ThreadedHashProcessor::prefetchAhead()
 {
-    return m_nextBlockIndexToWriteResultFor >= m_config.fileSlicesScheme.blockCount;
+    const auto& prefetch = m_config.prefetch;
+    if (!prefetch.file || prefetch.rangesAhead == 0) {
+        return;
+    }
+
+    const size_t prefetchEndBlock = std::min(
+                m_nextBlockIndexToScheduleReadAndHash + prefetch.rangesAhead * m_blocksPerJob,
+                m_config.fileSlicesScheme.blockCount);
+
+    // not yet scheduled ranges only - scheduled ones are read by workers already
+    const size_t prefetchStartBlock = std::max(m_nextBlockIndexToPrefetch, m_nextBlockIndexToScheduleReadAndHash);
+    if (prefetchStartBlock >= prefetchEndBlock) {
+        return;
+    }
+
+    const ss::SizeBytes blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+    TS_D3LOGF("prefetch [%d-%d]", prefetchStartBlock, prefetchEndBlock - prefetchStartBlock);
+    prefetch.file->adviseWillNeed(prefetchStartBlock * blockSizeBytes,
+                                  (prefetchEndBlock - prefetchStartBlock) * blockSizeBytes);
+
+    m_nextBlockIndexToPrefetch = prefetchEndBlock;
 }
 
 
-void ss::detail::threaded::ThreadedHashProcessor::resultsWriterWorker(const ss::DigestWriterPtr& writer)
+void ss::detail::threaded::ThreadedHashProcessor::dropBehindConsumers(bool isFinished)
 {
-    std::vector<tools::hash::Digest> digests;
+    const auto& prefetch = m_config.prefetch;
+    if (!prefetch.file || !prefetch.dropBehind) {
+        return;
+    }
+
+    // written results => blocks are hashed already. Drop by whole ranges to not spam syscalls
+    // NOTE: positional output mode: count of written blocks is not their prefix, slow job range may be dropped
+    // before it is read - advice only, so just extra read
+    const size_t dropEndBlock = m_nextBlockIndexToWriteResultFor;
+    const size_t minDropBlocksCount = isFinished ? 1 : m_blocksPerJob;
+    if (dropEndBlock < m_nextBlockIndexToDrop + minDropBlocksCount) {
+        return;
+    }
 
-    while (!isAllResultsDoneAndFlushed()) {
+    const ss::SizeBytes blockSizeBytes = m_config.fileSlicesScheme.blockSizeBytes;
+    TS_D3LOGF("drop [%d-%d]", m_nextBlockIndexToDrop, dropEndBlock - m_nextBlockIndexToDrop);
+    prefetch.file->adviseDontNeed(m_nextBlockIndexToDrop * blockSizeBytes,
+                                  (dropEndBlock - m_nextBlockIndexToDrop) * blockSizeBytes);
 
-        // try get next digests
-        {
-            std::unique_lock<std::mutex> guard(m_mutDigestsResults);
-            while (m_digestsResults.empty()) {
-                m_cvNextSequentalResultIsReady.wait(guard);
-            }
+    m_nextBlockIndexToDrop = dropEndBlock;
+}
 
-            // find next result
-            const auto it = m_digestsResults.find(m_nextBlockIndexToWriteResultFor.load());
-            if (it == m_digestsResults.end()) {
-                continue;
-            }
 
-            // get next results
-            digests = std::move(it->second);
-            TS_D3LOGF("writer: flush res [%d+%d]", it->first, digests.size());
+bool ss::detail::threaded::ThreadedHashProcessor::isAllResultsDoneAndFlushed() const
+{
+    return m_nextBlockIndexToWriteResultFor.load(std::memory_order_acquire) >= m_config.fileSlicesScheme.blockCount;
+}
+
+
+bool ss::detail::threaded::ThreadedHashProcessor::isStopRequested() const
+{
+    return m_config.writer && m_config.writer->isStopRequested();
+}
+
+
+void ss::detail::threaded::ThreadedHashProcessor::resultsWriterWorker(const ss::DigestWriterPtr& writer)
+{
+    tools::Backoff backoff;
+
+    // stop is requested by writer after write => no wait for results of not scheduled jobs
+    for(size_t jobIndex = 0; !isAllResultsDoneAndFlushed() && !isStopRequested(); ++jobIndex) {
+        ResultSlot& slot = resultSlot(jobIndex);
 
-            m_digestsResults.erase(it);
+        // wait for results in jobs order
+        backoff.reset();
+        while (!slot.isReady.load(std::memory_order_acquire)) {
+            backoff.pause();
         }
 
-        // do write
+        TS_D3LOGF("writer: flush res #%d [%d]", jobIndex, slot.digests.size());
+
         if (writer) {
-            for(const auto& digest : digests) {
-                writer->write(digest);
-            }
+            writer->write(slot.digests.data(), slot.digests.size());
         }
 
-        m_nextBlockIndexToWriteResultFor += digests.size();
+        // slot is free for next job => producer may schedule it
+        slot.isReady.store(false, std::memory_order_relaxed);
+        // release => producer sees finished jobs (reader buffers are released before publication)
+        m_nextBlockIndexToWriteResultFor.fetch_add(slot.digests.size(), std::memory_order_release);
+        m_nextJobIndexToWrite.store(jobIndex + 1, std::memory_order_release);
     }
 }
 
 
-size_t ss::detail::threaded::ThreadedHashProcessor::estimateMaxResultStoreCountLimit() const
+void ss::detail::threaded::ThreadedHashProcessor::tuneSetup()
 {
-    const ss::SizeBytes buffersMemoryConsume =
-            (m_config.fileSlicesScheme.blockSizeBytes + m_config.fileSlicesScheme.suggestedReadBufferSizeBytes)
-            * m_threadPoolSize;
+    if (!m_tuner) {
+        return;
+    }
 
-    const ss::SizeBytes singleHashMemConsume = m_config.hasherFactory->digestSize();
+    const ss::SizeBytes hashedBytes = m_hashedBlocksCount * m_config.fileSlicesScheme.blockSizeBytes;
+    if (!m_tuner->update(hashedBytes)) {
+        return;
+    }
 
-    const ss::SizeBytes maxResultStoreCountByMem = (ss::kMemoryConsumptionLimit - buffersMemoryConsume) / singleHashMemConsume;
+    // NOTE: already running jobs are not touched: extra threads are parked by limit after they finish,
+    // new range size is applied to next scheduled job
+    const auto& setup = m_tuner->setup();
+    m_activeThreadsLimit = setup.workersCount;
+    m_blocksPerJob = setup.blocksPerJob;
 
-    // NOTE: reduce by 2 cos evaluation very rude and mem limit is high
-    return maxResultStoreCountByMem / 2;
+    TS_D2LOGF("tune: threads: %d, blocks per job: %d", m_activeThreadsLimit, m_blocksPerJob);
 }
 
 
-void ss::detail::threaded::ThreadedHashProcessor::run(const ss::DigestWriterPtr& writer)
+ss::SizeBytes ss::detail::threaded::ThreadedHashProcessor::resultSlotMemoryConsume(size_t blocksPerJob) const
 {
-    m_threadPool->start();
+    return sizeof(ResultSlot)
+            + sizeof(tools::hash::Digest) * std::min(blocksPerJob, m_config.fileSlicesScheme.blockCount)
+            + ss::kHeapBlockOverheadBytes;
+}
+
 
-    std::thread writerThread([this, writer]() {
-        resultsWriterWorker(writer);
-    });
+ss::SizeBytes ss::detail::threaded::ThreadedHashProcessor::workerMemoryConsume(size_t blocksPerJob) const
+{
+    // NOTE: reader buffers: block buffer holds whole job range + read buffer, each job needs results slots
+    return m_config.fileSlicesScheme.blockSizeBytes * blocksPerJob
+            + m_config.fileSlicesScheme.suggestedReadBufferSizeBytes
+            + 2 * ss::kHeapBlockOverheadBytes
+            + 2 * resultSlotMemoryConsume(blocksPerJob);
+}
 
-    // main loop for producing read+hash tasks
-    while (!isAllResultsDoneAndFlushed()) {
 
-        checkAndWaitOnLimits();
+ss::SizeBytes ss::detail::threaded::ThreadedHashProcessor::asyncReadsMemoryConsume(size_t blocksPerThread, size_t buffersCount) const
+{
+    // NOTE: read buffers and minimal results slots count @see estimateResultSlotsCountLimit
+    const size_t minSlotsCount = m_isPositionalOutput ? 0 : 2 * std::max(m_threadPoolSize, buffersCount);
+    return (m_config.fileSlicesScheme.blockSizeBytes * blocksPerThread + ss::kHeapBlockOverheadBytes) * buffersCount
+            + minSlotsCount * resultSlotMemoryConsume(blocksPerThread);
+}
 
-        if (m_nextBlockIndexToScheduleReadAndHash < m_config.fileSlicesScheme.blockCount) {
+
+size_t ss::detail::threaded::ThreadedHashProcessor::estimateResultSlotsCountLimit(size_t maxJobsCount) const
+{
+    const ss::SizeBytes buffersMemoryConsume = m_asyncReadBuffersCount > 0
+            ? (m_config.fileSlicesScheme.blockSizeBytes * m_blocksPerThread + ss::kHeapBlockOverheadBytes) * m_asyncReadBuffersCount
+            : (workerMemoryConsume(m_blocksPerThread) - 2 * resultSlotMemoryConsume(m_blocksPerThread)) * m_threadPoolSize;
+
+    // at least all running jobs (or async reads) must be able to store results, twice - to not wait for writer
+    const size_t minSlotsCount = 2 * std::max(m_threadPoolSize, m_asyncReadBuffersCount);
+    const size_t maxSlotsCount = std::min(kMaxResultSlotsCount, maxJobsCount);
+
+    const ss::SizeBytes availableMemory = m_config.memoryBudget->limit() - buffersMemoryConsume;
+    const size_t memorySlotsCount = availableMemory > 0
+            ? static_cast<size_t>(availableMemory / resultSlotMemoryConsume(m_blocksPerThread))
+            : 0;
+
+    return std::max<size_t>(1, std::min(std::max(minSlotsCount, memorySlotsCount), std::max(minSlotsCount, maxSlotsCount)));
+}
+
+
+void ss::detail::threaded::ThreadedHashProcessor::run(const ss::DigestWriterPtr& writer)
+{
+    // consequent runs reuse threads, concurrent ones use own workers
+    m_sharedWorkersLock = ThreadedWorkers::tryLockShared();
+    if (m_sharedWorkersLock.owns_lock()) {
+        m_workers = &ThreadedWorkers::shared();
+    } else {
+        m_ownWorkers = std::make_unique<ThreadedWorkers>();
+        m_workers = m_ownWorkers.get();
+    }
+    m_workers->prepare(m_threadPoolSize, m_config);
+
+    // job owns promise => it may be still inside set_value when waiting is done
+    auto writerDone = std::make_shared<std::promise<void>>();
+    std::future<void> writerDoneFuture = writerDone->get_future();
+    if (m_isPositionalOutput) {
+        writerDone->set_value();
+    } else {
+        m_workers->writerPool().addJob(std::make_unique<FunctionJob>([this, writer, writerDone]() {
+            resultsWriterWorker(writer);
+            writerDone->set_value();
+        }));
+    }
+
+    if (m_config.asyncReads.file) {
+        asyncReadsProducer();
+    } else {
+        // main loop for producing read+hash tasks
+        while (m_nextBlockIndexToScheduleReadAndHash < m_config.fileSlicesScheme.blockCount) {
+            checkAndWaitOnLimits();
+            if (isStopRequested()) {
+                TS_DLOGF("stop requested, not scheduled blocks: %d",
+                         m_config.fileSlicesScheme.blockCount - m_nextBlockIndexToScheduleReadAndHash);
+                break;
+            }
+            tuneSetup();
             scheduleNextReadAndHashJob();
         }
     }
 
-    // finalize writer thread
-    m_cvNextSequentalResultIsReady.notify_all();
-    writerThread.join();
+    writerDoneFuture.wait();
+
+    // all scheduled jobs are done (positional output mode: all results are written),
+    // jobs still touch shared state right after last results publication
+    waitJobsFinished();
+
+    dropBehindConsumers(true);
+
+    // contexts hold file and buffers => not kept by process-wide workers
+    m_workers->release();
+    m_workers = nullptr;
+    m_ownWorkers.reset();
+    m_sharedWorkersLock = std::unique_lock<std::mutex>();
 }
 
 
-ss::detail::threaded::ThreadedHashProcessor::BlockReaderAndHasherLocker::BlockReaderAndHasherLocker(ThreadedHashProcessor *owner)
-    : owner(owner)
+void ss::detail::threaded::ThreadedHashProcessor::waitJobsFinished() const
 {
-    blockReaderHasher = owner->acquireBlockReaderHasher();
+    tools::Backoff backoff;
+    while (m_runningHasherJobsCount.load(std::memory_order_acquire) > 0) {
+        backoff.pause();
+    }
 }
 
 
-ss::detail::threaded::ThreadedHashProcessor::BlockReaderAndHasherLocker::~BlockReaderAndHasherLocker()
+void ss::detail::threaded::ThreadedHashProcessor::asyncReadsProducer()
 {
-    try {
-        if (owner != nullptr) {
-            owner->releaseBlockReaderHasher(blockReaderHasher);
+    // buffers are used by hash jobs => reader must outlive them
+    UringRangesReader reader(m_config.asyncReads.file,
+                             m_config.fileSlicesScheme,
+                             m_blocksPerThread,
+                             m_config.asyncReads.queueDepth,
+                             m_asyncReadBuffersCount,
+                             m_config.memoryBudget);
+
+    std::vector<UringRangesReader::Range> completedRanges;
+    tools::Backoff backoff;
+
+    while (!reader.isFinished()) {
+        // stopped: no new reads, reads in flight are drained - kernel writes to buffers
+        const bool isStopped = isStopRequested();
+        if (isStopped && !reader.hasReadsInFlight()) {
+            break;
+        }
+
+        // do not read ahead of results ring, but completed reads must be hashed anyway.
+        // Positional output mode: reads are paced by read buffers only
+        if (!isStopped) {
+            const size_t blocksLimit = m_isPositionalOutput
+                    ? m_config.fileSlicesScheme.blockCount
+                    : (m_nextJobIndexToWrite.load(std::memory_order_acquire) + m_resultSlotsCount) * m_blocksPerThread;
+            reader.submitReads(blocksLimit);
+        }
+        if (!reader.hasReadsInFlight()) {
+            backoff.pause();
+            continue;
+        }
+        backoff.reset();
+
+        completedRanges.clear();
+        reader.waitCompletedRanges(completedRanges);
+
+        for(const auto& range : completedRanges) {
+            if (isStopped) {
+                reader.releaseBuffer(range.bufferIndex);
+            } else {
+                scheduleHashJob(range, &reader);
+            }
         }
-    } catch(...) {}
+
+        // NOTE: no prefetch - reads queue is read-ahead itself
+        dropBehindConsumers();
+    }
+
+    // wait for hash jobs done with reader buffers
+    waitJobsFinished();
+}
+
+
+void ss::detail::threaded::ThreadedHashProcessor::scheduleHashJob(const UringRangesReader::Range &range, UringRangesReader *reader)
+{
+    // reads are submitted in ranges order, each range is one job
+    const size_t jobIndex = range.firstBlockIndex / m_blocksPerThread;
+
+    m_runningHasherJobsCount++;
+    TS_D3LOGF("enqueue hash job #%d [%d-%d]", jobIndex, range.firstBlockIndex, range.count);
+
+    m_workers->hashersPool().addJob(std::make_unique<HasherJob>(jobIndex, range, reader, this));
 }
 
 
@@ -224,3 +527,22 @@ tools::hash::Digest ss::detail::threaded::BlockReaderAndHasher::readSingleBlockA
     const auto bufferView = reader->readSingleBlock(blockIndex);
     return hasher->hash(bufferView);
 }
+
+
+void ss::detail::threaded::BlockReaderAndHasher::readBlocksAndCalculateHashes(size_t firstBlockIndex, size_t count, tools::hash::Digest *digests)
+{
+    calculateHashes(reader->readBlocks(firstBlockIndex, count), count, digests);
+}
+
+
+void ss::detail::threaded::BlockReaderAndHasher::calculateHashes(std::string_view data, size_t count, tools::hash::Digest *digests)
+{
+    const size_t blockSizeBytes = reader->fileSlicesScheme().blockSizeBytes;
+    m_blocks.resize(count);
+
+    for(size_t i = 0; i < count; ++i) {
+        m_blocks[i] = data.substr(i * blockSizeBytes, blockSizeBytes);
+    }
+
+    hasher->hashMany(m_blocks.data(), count, digests);
+}
@@ -5,16 +5,16 @@
 #include "reader.hpp"
 #include "writers/abstract_writer.hpp"
 #include "strategies/abstract_strategy.hpp"
+#include "readers/uring_reader.hpp"
+#include "strategies/detail/threaded/adaptive_tuner.hpp"
+#include "strategies/detail/threaded/workers.hpp"
 
 #include <tools/hash/abstract_hasher.hpp>
-#include <tools/thread_pool.hpp>
-
-#include <stack>
-#include <unordered_map>
+#include <tools/spsc_queue.hpp>
 
 #include <atomic>
+#include <memory>
 #include <mutex>
-#include <condition_variable>
 
 
 namespace ss {
@@ -27,15 +27,30 @@ namespace threaded {
 struct BlockReaderAndHasher {
     ss::FileBlockReaderPtr reader;
     tools::hash::HasherPtr hasher;
+    /// results storage of positional output mode: job writes them at once @see ThreadedHashProcessor::storeJobResults
+    std::vector<tools::hash::Digest> digests;
 
     BlockReaderAndHasher(const FileBlockReaderPtr &reader,
             const tools::hash::HasherPtr& hasher);
 
     tools::hash::Digest readSingleBlockAndCalculateHash(size_t blockIndex);
-};
 
+    /**
+     * @brief read sequental blocks by single read and hash them by single call
+     * @param digests - output, count items
+     */
+    void readBlocksAndCalculateHashes(size_t firstBlockIndex, size_t count, tools::hash::Digest* digests);
+
+    /**
+     * @brief hash already read sequental blocks by single call
+     * @param data - count * blockSize bytes
+     * @param digests - output, count items
+     */
+    void calculateHashes(std::string_view data, size_t count, tools::hash::Digest* digests);
 
-using BlockReaderAndHasherPtr = std::shared_ptr<BlockReaderAndHasher>;
+private:
+    std::vector<std::string_view> m_blocks;
+};
 
 
 /**
@@ -49,10 +64,13 @@ public:
      * @param config - config from strategy (factories, slice scheme etc)
      * @param poolSizeHint
      * @param singleThreadSequentalRangeSize
+     * @param isAdaptive - tune active threads count and job range size while running (synchronous reads only),
+     *  hints are used as initial setup
      */
     ThreadedHashProcessor(const ss::AbstractHashStrategy::Configuration& config,
             size_t threadPoolSizeHint,
-            ss::SizeBytes singleThreadSequentalRangeSizeBytes);
+            ss::SizeBytes singleThreadSequentalRangeSizeBytes,
+            bool isAdaptive = false);
 
     /**
      * @brief main runner
@@ -61,53 +79,102 @@ public:
 
     // reader job helper API to get reusable context (reader, hasher), publicate results
 
-    BlockReaderAndHasherPtr acquireBlockReaderHasher();
-    void releaseBlockReaderHasher(const BlockReaderAndHasherPtr& ctx);
-
-    struct BlockReaderAndHasherLocker {
-        ThreadedHashProcessor *owner = nullptr;
-        BlockReaderAndHasherPtr blockReaderHasher;
-        BlockReaderAndHasherLocker(ThreadedHashProcessor *owner);
-        ~BlockReaderAndHasherLocker();
-    };
-
-    void publicateFinishedJobResults(size_t startBlock, std::vector<tools::hash::Digest>&& digests);
-
-private:
-    ss::AbstractHashStrategy::Configuration m_config;
+    /**
+     * @brief context (reader, hasher) of current pool worker, created on first use.
+     * Each worker uses only own context => no locking
+     * MT: must be called from pool worker only @see ThreadedWorkers
+     */
+    const BlockReaderAndHasherPtr& workerBlockReaderHasher();
 
-    std::unique_ptr<tools::ThreadPool> m_threadPool;
+    /**
+     * @brief digests storage of job results. Job owns it from scheduling till publication,
+     * storage is reused => no allocations in steady state
+     * @param jobIndex - sequence number of job (ranges order)
+     * @param blockReaderHasher - context of job worker, its storage is used in positional output mode
+     */
+    std::vector<tools::hash::Digest>& jobResultDigests(size_t jobIndex, BlockReaderAndHasher& blockReaderHasher);
 
-    size_t m_threadPoolSize;
-    size_t m_blocksPerThread;
-    size_t m_maxResultVectorStoreCount;
+    /**
+     * @brief positional output mode: write job results at their offsets by job thread,
+     * results ring: nothing to do, results are written by writer in jobs order after publication
+     */
+    void storeJobResults(size_t firstBlockIndex, const std::vector<tools::hash::Digest>& digests);
 
-    // results storage
-    std::mutex m_mutDigestsResults;
-    std::unordered_map<size_t, std::vector<tools::hash::Digest>> m_digestsResults;
+    /**
+     * @brief mark job results ready to be written (results ring) or done (positional output mode)
+     */
+    void publicateFinishedJobResults(size_t jobIndex, size_t blocksCount);
 
-    // reusabe readers/hasher contexts
-    std::mutex m_mutReadersJobsContexts;
-    std::vector<BlockReaderAndHasherPtr> m_readersJobsContexts;         ///< all
-    std::stack<BlockReaderAndHasherPtr> m_availableReadersJobsContexts; ///< free to use
+private:
+    /// results ring slot, filled by job, consumed by writer in jobs order
+    struct alignas(tools::kCacheLineSize) ResultSlot {
+        std::atomic_bool isReady = false;
+        std::vector<tools::hash::Digest> digests;
+    };
 
-    // limiting sync
-    std::condition_variable m_cvSomeReadAndHashJobFinished;
-    std::condition_variable m_cvNextSequentalResultIsReady;
+    ss::AbstractHashStrategy::Configuration m_config;
 
-    // runtime counters
-    std::atomic_size_t m_runningHasherJobsCount = 0;
+    /// writer supports writes at blocks offsets => jobs write own results, no results ring and writer thread
+    bool m_isPositionalOutput = false;
+
+    // process-wide workers if not used by other processor, otherwise own ones
+    std::unique_lock<std::mutex> m_sharedWorkersLock;
+    std::unique_ptr<ThreadedWorkers> m_ownWorkers;
+    ThreadedWorkers* m_workers = nullptr;
+
+    size_t m_threadPoolSize;            ///< max count of concurrent jobs, pool may be bigger
+    size_t m_blocksPerThread;           ///< max job range, memory estimations are based on it
+    size_t m_blocksPerJob;              ///< current job range, <= m_blocksPerThread
+    size_t m_activeThreadsLimit;        ///< current running jobs limit, <= m_threadPoolSize
+    size_t m_asyncReadBuffersCount = 0;
+
+    // results ring: job with index i uses slot i % count, scheduled only when writer freed it. Empty in positional output mode
+    std::unique_ptr<ResultSlot[]> m_resultSlots;
+    size_t m_resultSlotsCount = 0;
+    MemoryBudget::Lease m_resultSlotsLease;
+
+    // runtime counters, shared ones are padded to not share cache lines
+    alignas(tools::kCacheLineSize) std::atomic_size_t m_runningHasherJobsCount = 0;
+    alignas(tools::kCacheLineSize) std::atomic_size_t m_nextJobIndexToWrite = 0;
+    std::atomic_size_t m_nextBlockIndexToWriteResultFor = 0;   ///< positional output mode: count of written blocks
+    alignas(tools::kCacheLineSize) std::atomic_size_t m_hashedBlocksCount = 0;
+
+    // producer (main thread) only
+    alignas(tools::kCacheLineSize) size_t m_nextJobIndexToSchedule = 0;
     size_t m_nextBlockIndexToScheduleReadAndHash = 0;
-    std::atomic_size_t m_nextBlockIndexToWriteResultFor = 0;
+    size_t m_nextBlockIndexToPrefetch = 0;
+    size_t m_nextBlockIndexToDrop = 0;
+
+    std::unique_ptr<AdaptiveTuner> m_tuner;
 
     ///
 
     bool isAllResultsDoneAndFlushed() const;
-    size_t estimateMaxResultStoreCountLimit() const;
+    /// writer needs no more results => no new jobs and reads, running ones are finished
+    bool isStopRequested() const;
+    size_t estimateResultSlotsCountLimit(size_t maxJobsCount) const;
+    ss::SizeBytes resultSlotMemoryConsume(size_t blocksPerJob) const;
+    /// memory held by single pool worker (reader buffers) and its results slots
+    ss::SizeBytes workerMemoryConsume(size_t blocksPerJob) const;
+    /// asynchronous reads mode: read buffers and minimal count of results slots
+    ss::SizeBytes asyncReadsMemoryConsume(size_t blocksPerThread, size_t buffersCount) const;
+    ResultSlot& resultSlot(size_t jobIndex);
 
     void checkAndWaitOnLimits();
     void scheduleNextReadAndHashJob();
     void resultsWriterWorker(const DigestWriterPtr &writer);
+    void waitJobsFinished() const;
+    void tuneSetup();
+
+    // asynchronous reads mode: main thread reads, pool threads only hash
+
+    void asyncReadsProducer();
+    void scheduleHashJob(const UringRangesReader::Range& range, UringRangesReader* reader);
+
+    // OS read-ahead hints, main thread only
+
+    void prefetchAhead();
+    void dropBehindConsumers(bool isFinished = false);
 };
 
 
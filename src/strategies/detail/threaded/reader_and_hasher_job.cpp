@@ -6,8 +6,9 @@
 TS_LOGGER("hash.threaded.job")
 
 
-ss::detail::threaded::ReaderAndHasherJob::ReaderAndHasherJob(size_t startBlock, size_t endBlock, ThreadedHashProcessor *ctx)
-    : m_startBlock(startBlock)
+ss::detail::threaded::ReaderAndHasherJob::ReaderAndHasherJob(size_t jobIndex, size_t startBlock, size_t endBlock, ThreadedHashProcessor *ctx)
+    : m_jobIndex(jobIndex)
+    , m_startBlock(startBlock)
     , m_endBlock(endBlock)
     , m_ctx(ctx)
 {
@@ -17,8 +18,7 @@ ss::detail::threaded::ReaderAndHasherJob::ReaderAndHasherJob(size_t startBlock,
 void ss::detail::threaded::ReaderAndHasherJob::doRun()
 {
     try {
-        ThreadedHashProcessor::BlockReaderAndHasherLocker readerHolder(m_ctx);
-        execute(readerHolder.blockReaderHasher);
+        execute(m_ctx->workerBlockReaderHasher());
     } catch (const std::exception& e) {
         TS_ELOGF("hash job failed [%d]: %s", m_startBlock, e.what());
         std::abort();
@@ -31,12 +31,10 @@ void ss::detail::threaded::ReaderAndHasherJob::doRun()
 
 void ss::detail::threaded::ReaderAndHasherJob::execute(const BlockReaderAndHasherPtr &blockReaderHasher)
 {
-    std::vector<tools::hash::Digest> seqDigests;
-    seqDigests.reserve(m_endBlock - m_startBlock);
+    auto& digests = m_ctx->jobResultDigests(m_jobIndex, *blockReaderHasher);
+    digests.resize(m_endBlock - m_startBlock);
 
-    for(size_t blockIndex = m_startBlock; blockIndex < m_endBlock; ++blockIndex) {
-        seqDigests.push_back(blockReaderHasher->readSingleBlockAndCalculateHash(blockIndex));
-    }
-
-    m_ctx->publicateFinishedJobResults(m_startBlock, std::move(seqDigests));
+    blockReaderHasher->readBlocksAndCalculateHashes(m_startBlock, digests.size(), digests.data());
+    m_ctx->storeJobResults(m_startBlock, digests);
+    m_ctx->publicateFinishedJobResults(m_jobIndex, digests.size());
 }
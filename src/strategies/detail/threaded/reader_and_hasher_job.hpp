@@ -12,13 +12,14 @@ namespace threaded {
 
 class ReaderAndHasherJob : public tools::ThreadPool::IJob {
 public:
-    ReaderAndHasherJob(size_t startBlock, size_t endBlock, ThreadedHashProcessor* ctx);
+    ReaderAndHasherJob(size_t jobIndex, size_t startBlock, size_t endBlock, ThreadedHashProcessor* ctx);
 
 protected:
 
     void doRun() override;
 
 private:
+    size_t m_jobIndex = 0;
     size_t m_startBlock = 0;
     size_t m_endBlock = 0;
     ThreadedHashProcessor* m_ctx = nullptr;
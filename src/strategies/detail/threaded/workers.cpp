@@ -0,0 +1,93 @@
+#include "workers.hpp"
+
+#include <cassert>
+#include <tools/log.hpp>
+
+#include "strategies/detail/threaded/processor.hpp"
+
+
+TS_LOGGER("hash.threaded.workers")
+
+
+namespace {
+
+std::mutex mutSharedWorkers;
+
+} // ns anonymous
+
+
+ss::detail::threaded::ThreadedWorkers::~ThreadedWorkers() noexcept
+{
+    // pools first - jobs may still use contexts
+    m_writerPool.reset();
+    m_hashersPool.reset();
+}
+
+
+ss::detail::threaded::ThreadedWorkers &ss::detail::threaded::ThreadedWorkers::shared()
+{
+    static ThreadedWorkers instance;
+    return instance;
+}
+
+
+std::unique_lock<std::mutex> ss::detail::threaded::ThreadedWorkers::tryLockShared()
+{
+    return std::unique_lock<std::mutex>(mutSharedWorkers, std::try_to_lock);
+}
+
+
+void ss::detail::threaded::ThreadedWorkers::prepare(size_t threadsCount, const ss::AbstractHashStrategy::Configuration& config)
+{
+    if (!m_hashersPool || m_hashersPool->size() < threadsCount) {
+        TS_D2LOGF("start hashers pool: %d threads", threadsCount);
+        m_hashersPool = std::make_unique<tools::WorkStealingThreadPool>(threadsCount);
+        m_hashersPool->start();
+    }
+    m_workersContexts.resize(m_hashersPool->size());
+    if (!m_writerPool) {
+        m_writerPool = std::make_unique<tools::WorkStealingThreadPool>(1);
+        m_writerPool->start();
+    }
+
+    // NOTE: contexts of previous run are released by it, but it may be interrupted by exception
+    std::fill(m_workersContexts.begin(), m_workersContexts.end(), nullptr);
+    m_readerFactory = config.readerfactory;
+    m_hasherFactory = config.hasherFactory;
+}
+
+
+void ss::detail::threaded::ThreadedWorkers::release()
+{
+    std::fill(m_workersContexts.begin(), m_workersContexts.end(), nullptr);
+    m_readerFactory.reset();
+    m_hasherFactory.reset();
+}
+
+
+tools::WorkStealingThreadPool &ss::detail::threaded::ThreadedWorkers::hashersPool()
+{
+    return *m_hashersPool;
+}
+
+
+tools::WorkStealingThreadPool &ss::detail::threaded::ThreadedWorkers::writerPool()
+{
+    return *m_writerPool;
+}
+
+
+const ss::detail::threaded::BlockReaderAndHasherPtr& ss::detail::threaded::ThreadedWorkers::workerBlockReaderHasher()
+{
+    const size_t workerIndex = tools::ThreadPool::currentWorkerIndex();
+    assert(workerIndex < m_workersContexts.size() && "must be called from hashers pool worker");
+
+    // NOTE: factories are not changed while processor runs
+    auto& res = m_workersContexts[workerIndex];
+    if (!res) {
+        res = std::make_shared<ss::detail::threaded::BlockReaderAndHasher>(
+                    m_readerFactory->create(),
+                    m_hasherFactory->create());
+    }
+    return res;
+}
@@ -0,0 +1,93 @@
+#ifndef SS_STRATEGIES_THREADED_WORKERS_H
+#define SS_STRATEGIES_THREADED_WORKERS_H
+#pragma once
+
+#include "strategies/abstract_strategy.hpp"
+
+#include <tools/work_stealing_thread_pool.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace ss {
+namespace detail {
+namespace threaded {
+
+
+struct BlockReaderAndHasher;
+using BlockReaderAndHasherPtr = std::shared_ptr<BlockReaderAndHasher>;
+
+
+/**
+ * @brief Long-lived workers of threaded processor: hashing threads pool, results writer thread and
+ * per-worker reader/hasher contexts slots. Process-wide instance is reused by consequent hash() calls,
+ * so threads are created once. Pool only grows, contexts live within single run only (they hold file and buffers)
+ * MT: used by single processor at once, each pool worker uses only own context slot
+ */
+class ThreadedWorkers {
+public:
+    ThreadedWorkers() = default;
+    ~ThreadedWorkers() noexcept;
+
+    ThreadedWorkers(const ThreadedWorkers&) = delete;
+    ThreadedWorkers(ThreadedWorkers&&) = delete;
+    ThreadedWorkers& operator=(const ThreadedWorkers&) = delete;
+    ThreadedWorkers& operator=(ThreadedWorkers&&) = delete;
+
+    /**
+     * @brief process-wide instance, must be locked by its user @see tryLockShared
+     */
+    static ThreadedWorkers& shared();
+
+    /**
+     * @brief exclusive use of process-wide instance
+     * @return not owning lock if it is used by other processor now (concurrent hash() calls)
+     */
+    static std::unique_lock<std::mutex> tryLockShared();
+
+    /**
+     * @brief prepare for processor run: pools are started, hashing pool has at least threadsCount threads,
+     * contexts slots are bound to run factories
+     * @param threadsCount - max count of concurrent jobs
+     */
+    void prepare(size_t threadsCount, const ss::AbstractHashStrategy::Configuration& config);
+
+    /**
+     * @brief end of processor run: contexts (readers, buffers) and factories are released
+     * MT: no jobs must be running
+     */
+    void release();
+
+    tools::WorkStealingThreadPool& hashersPool();
+
+    /**
+     * @brief single thread pool for results writer
+     */
+    tools::WorkStealingThreadPool& writerPool();
+
+    /**
+     * @brief context (reader, hasher) of current hashers pool worker, created on first use in run.
+     * Each worker uses only own context => no locking
+     * MT: must be called from hashers pool worker only
+     */
+    const BlockReaderAndHasherPtr& workerBlockReaderHasher();
+
+private:
+    std::unique_ptr<tools::WorkStealingThreadPool> m_hashersPool;
+    std::unique_ptr<tools::WorkStealingThreadPool> m_writerPool;
+
+    // factories of current run
+    ss::FileBlockReaderFactoryPtr m_readerFactory;
+    tools::hash::HasherFactoryPtr m_hasherFactory;
+
+    // reusable readers/hasher contexts, indexed by hashers pool worker index
+    std::vector<BlockReaderAndHasherPtr> m_workersContexts;
+};
+
+
+}}} // ns ss::detail::threaded
+
+
+#endif // SS_STRATEGIES_THREADED_WORKERS_H
@@ -0,0 +1,65 @@
+#include "pipeline_strategy.hpp"
+
+#include <thread>
+
+#include "consts.hpp"
+#include "strategies/detail/pipeline/processor.hpp"
+
+
+ss::PipelineHashStrategy::PipelineHashStrategy(size_t readerThreadsHint, size_t hasherThreadsHint, SizeBytes rangeSize, SizeBytes readSize)
+    : m_readerThreadsHint(readerThreadsHint)
+    , m_hasherThreadsHint(hasherThreadsHint)
+    , m_rangeSize(rangeSize)
+    , m_readSize(readSize)
+{
+    if (m_readerThreadsHint == 0) {
+        m_readerThreadsHint = 1;
+    }
+    if (m_hasherThreadsHint == 0) {
+        m_hasherThreadsHint = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+
+std::shared_ptr<ss::PipelineHashStrategy> ss::PipelineHashStrategy::createSingleStream(size_t hasherThreadsHint,
+        SizeBytes rangeSize, SizeBytes readSize)
+{
+    auto res = std::make_shared<PipelineHashStrategy>(1, hasherThreadsHint, rangeSize,
+                                                      readSize > 0 ? readSize : ss::kSingleStreamReadSizeBytes);
+    res->m_isSingleStream = true;
+    return res;
+}
+
+
+void ss::PipelineHashStrategy::doHash(const Configuration &config)
+{
+    ss::detail::pipeline::PipelineHashProcessor ctx(config, m_readerThreadsHint, m_hasherThreadsHint, effectiveRangeSize(config), m_readSize);
+
+    ctx.run(config.writer);
+}
+
+
+ss::SizeBytes ss::PipelineHashStrategy::effectiveRangeSize(const Configuration &config) const
+{
+    SizeBytes effRangeSize = m_rangeSize > 0
+            ? m_rangeSize
+            : config.fileSlicesScheme.suggestedReadBufferSizeBytes;
+
+    if (effRangeSize == 0) {
+        effRangeSize = ss::kDefaultSingleThreadSequentalRangeSize;
+    }
+    return effRangeSize;
+}
+
+
+ss::StrategySpec ss::PipelineHashStrategy::getConfigurationSpec(const Configuration &config) const
+{
+    StrategySpec spec;
+    spec.kind = m_isSingleStream ? 'H' : 'P';
+    spec.readers = m_isSingleStream ? 0 : m_readerThreadsHint;
+    spec.hashers = m_hasherThreadsHint;
+    spec.range = effectiveRangeSize(config);
+    // NOTE: read size 0 => range size is read at once
+    spec.read = m_readSize > 0 ? m_readSize : spec.range;
+    return spec;
+}
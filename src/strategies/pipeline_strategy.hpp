@@ -0,0 +1,48 @@
+#ifndef SS_STRATEGIES_PIPELINE_STRATEGY_H
+#define SS_STRATEGIES_PIPELINE_STRATEGY_H
+#pragma once
+
+#include "strategies/abstract_strategy.hpp"
+
+namespace ss {
+
+/**
+ * @brief Pipeline processing strategy: separate reader and hasher threads,
+ * so count of concurrent I/O streams is tuned independently of hashing threads count
+ * lightweight class, all internals are hided in helper class
+ */
+class PipelineHashStrategy : public AbstractHashStrategy
+{
+public:
+    /**
+     * @param readerThreadsHint - count of reading threads. 0 => autochoose
+     * @param hasherThreadsHint - count of hashing threads. 0 => autochoose
+     * @param rangeSize - size of range hashed by single thread at once in bytes. 0 => autochoose
+     * @param readSize - size of single read in bytes, split to ranges for hashers. 0 => range size
+     */
+    PipelineHashStrategy(size_t readerThreadsHint = 0, size_t hasherThreadsHint = 0, SizeBytes rangeSize = 0, SizeBytes readSize = 0);
+
+    /**
+     * @brief rotational disks mode: single strictly sequental stream of large reads,
+     * blocks are fanned out to hashers in memory
+     * @param hasherThreadsHint - count of hashing threads. 0 => autochoose
+     * @param rangeSize - size of range hashed by single thread at once in bytes. 0 => autochoose
+     * @param readSize - size of single read in bytes. 0 => default large one
+     */
+    static std::shared_ptr<PipelineHashStrategy> createSingleStream(size_t hasherThreadsHint = 0, SizeBytes rangeSize = 0,
+            SizeBytes readSize = 0);
+private:
+    size_t m_readerThreadsHint = 0;
+    size_t m_hasherThreadsHint = 0;
+    SizeBytes m_rangeSize = 0;
+    SizeBytes m_readSize = 0;
+    bool m_isSingleStream = false;
+
+    void doHash(const Configuration &config) override;
+    ss::StrategySpec getConfigurationSpec(const Configuration &config) const override;
+    SizeBytes effectiveRangeSize(const Configuration &config) const;
+};
+
+} // ns ss
+
+#endif // SS_STRATEGIES_PIPELINE_STRATEGY_H
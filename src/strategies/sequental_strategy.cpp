@@ -1,28 +1,235 @@
 #include "sequental_strategy.hpp"
 
 #include "reader.hpp"
+#include "consts.hpp"
+#include "readers/direct_reader.hpp"
 
 #include <tools/hash/digest.hpp>
+#include <tools/log.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+
+TS_LOGGER("hash.sequental")
+
+
+namespace {
+
+
+/// batch buffer of overlapped I/O: own reader => own buffer
+struct BatchSlot {
+    ss::FileBlockReaderPtr reader;
+    std::string_view data;
+    size_t count = 0;
+    bool isReady = false;   ///< read and waiting for hashing
+};
+
+
+/// batch buffers (+ read buffers) of all readers must fit half of memory budget
+ss::SizeBytes maxBatchSizeBytes(const ss::AbstractHashStrategy::Configuration& config, size_t readersCount)
+{
+    return config.memoryBudget->limit() / 2 / static_cast<ss::SizeBytes>(readersCount)
+            - config.fileSlicesScheme.suggestedReadBufferSizeBytes;
+}
+
+
+/// upper bound of buffers held by single reader of batches: batch (chunk readers - at least read buffer), direct I/O alignment
+ss::SizeBytes readerMemoryConsume(const ss::AbstractHashStrategy::Configuration& config, size_t batchSize)
+{
+    return config.fileSlicesScheme.blockSizeBytes * static_cast<ss::SizeBytes>(batchSize)
+            + config.fileSlicesScheme.suggestedReadBufferSizeBytes
+            + 2 * ss::DirectFileBlockReader::kDefaultAlignmentBytes
+            + 2 * ss::kHeapBlockOverheadBytes;
+}
+
+
+} // ns anonymous
+
+
+ss::SequentalHashStrategy::SequentalHashStrategy(size_t readAheadDepth)
+    : m_readAheadDepth(readAheadDepth)
+{
+}
+
+
+size_t ss::SequentalHashStrategy::fitReadAheadDepth(const Configuration &config) const
+{
+    const SizeBytes memoryLimitBytes = config.memoryBudget->limit();
+
+    size_t depth = m_readAheadDepth;
+    while (depth >= 2) {
+        const size_t batchSize = suggestHashBatchBlocksCount(config.fileSlicesScheme, config.hasherFactory,
+                                                             maxBatchSizeBytes(config, depth));
+        if (readerMemoryConsume(config, batchSize) * static_cast<SizeBytes>(depth) <= memoryLimitBytes) {
+            break;
+        }
+        --depth;
+    }
+
+    if (depth != m_readAheadDepth) {
+        TS_DLOGF("overlapped reads depth is lowered by memory limit: %d => %d", m_readAheadDepth, depth);
+    }
+    return depth;
+}
 
 
 void ss::SequentalHashStrategy::doHash(const Configuration &config)
 {
+    const size_t readAheadDepth = fitReadAheadDepth(config);
+    const size_t readersCount = readAheadDepth >= 2 ? readAheadDepth : 1;
+    const size_t batchSize = suggestHashBatchBlocksCount(config.fileSlicesScheme, config.hasherFactory,
+                                                         maxBatchSizeBytes(config, readersCount));
+    if (readAheadDepth >= 2 && config.fileSlicesScheme.blockCount > batchSize) {
+        hashOverlapped(config, readAheadDepth);
+        return;
+    }
+
     auto reader = config.readerfactory->create();
     auto hasher = config.hasherFactory->create();
 
     const bool writerAvailable = config.writer.get() != nullptr;
 
     const auto N = config.fileSlicesScheme.blockCount;
-    for(size_t i = 0; i < N; ++i) {
-        const auto digest = hasher->hash(reader->readSingleBlock(i));
+    const size_t blockSizeBytes = config.fileSlicesScheme.blockSizeBytes;
+
+    std::vector<std::string_view> blocks(batchSize);
+    std::vector<tools::hash::Digest> digests(batchSize);
+
+    for(size_t i = 0; i < N; i += batchSize) {
+        const size_t n = std::min(batchSize, N - i);
+        const auto data = reader->readBlocks(i, n);
+        for(size_t j = 0; j < n; ++j) {
+            blocks[j] = data.substr(j * blockSizeBytes, blockSizeBytes);
+        }
+
+        hasher->hashMany(blocks.data(), n, digests.data());
+
         if (writerAvailable) {
-            config.writer->write(digest);
+            config.writer->write(digests.data(), n);
+            if (config.writer->isStopRequested()) {
+                break;
+            }
+        }
+    }
+}
+
+
+void ss::SequentalHashStrategy::hashOverlapped(const Configuration &config, size_t readAheadDepth)
+{
+    auto hasher = config.hasherFactory->create();
+
+    const bool writerAvailable = config.writer.get() != nullptr;
+
+    const auto N = config.fileSlicesScheme.blockCount;
+    const size_t blockSizeBytes = config.fileSlicesScheme.blockSizeBytes;
+    const size_t batchSize = suggestHashBatchBlocksCount(config.fileSlicesScheme, config.hasherFactory,
+                                                         maxBatchSizeBytes(config, readAheadDepth));
+
+    std::vector<BatchSlot> slots(readAheadDepth);
+    for(auto& slot : slots) {
+        slot.reader = config.readerfactory->create();
+    }
+
+    std::mutex mutSlots;
+    std::condition_variable cvSlotChanged;
+    bool isStopped = false;
+    std::exception_ptr readError;
+
+    // batch k is read into slot k % depth, slot is reused after it's hashed
+    std::thread readerThread([&]() {
+        try {
+            for(size_t i = 0, k = 0; i < N; i += batchSize, ++k) {
+                BatchSlot& slot = slots[k % slots.size()];
+                {
+                    std::unique_lock<std::mutex> guard(mutSlots);
+                    cvSlotChanged.wait(guard, [&]() {
+                        return !slot.isReady || isStopped;
+                    });
+                    if (isStopped) {
+                        return;
+                    }
+                }
+
+                const size_t n = std::min(batchSize, N - i);
+                const auto data = slot.reader->readBlocks(i, n);
+
+                {
+                    std::lock_guard<std::mutex> guard(mutSlots);
+                    slot.data = data;
+                    slot.count = n;
+                    slot.isReady = true;
+                }
+                cvSlotChanged.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(mutSlots);
+            readError = std::current_exception();
+            cvSlotChanged.notify_all();
+        }
+    });
+
+    const auto stopReader = [&]() {
+        {
+            std::lock_guard<std::mutex> guard(mutSlots);
+            isStopped = true;
         }
+        cvSlotChanged.notify_all();
+        readerThread.join();
+    };
+
+    std::vector<std::string_view> blocks(batchSize);
+    std::vector<tools::hash::Digest> digests(batchSize);
+
+    try {
+        for(size_t i = 0, k = 0; i < N; i += batchSize, ++k) {
+            BatchSlot& slot = slots[k % slots.size()];
+            {
+                std::unique_lock<std::mutex> guard(mutSlots);
+                cvSlotChanged.wait(guard, [&]() {
+                    return slot.isReady || readError;
+                });
+                if (!slot.isReady) {
+                    std::rethrow_exception(readError);
+                }
+            }
+
+            const size_t n = slot.count;
+            for(size_t j = 0; j < n; ++j) {
+                blocks[j] = slot.data.substr(j * blockSizeBytes, blockSizeBytes);
+            }
+
+            hasher->hashMany(blocks.data(), n, digests.data());
+
+            {
+                std::lock_guard<std::mutex> guard(mutSlots);
+                slot.isReady = false;
+            }
+            cvSlotChanged.notify_all();
+
+            if (writerAvailable) {
+                config.writer->write(digests.data(), n);
+                if (config.writer->isStopRequested()) {
+                    break;
+                }
+            }
+        }
+    } catch (...) {
+        stopReader();
+        throw;
     }
+
+    stopReader();
 }
 
 
-std::string ss::SequentalHashStrategy::getConfigurationStringRepresentation() const
+ss::StrategySpec ss::SequentalHashStrategy::getConfigurationSpec(const Configuration &) const
 {
-    return "S";
+    StrategySpec spec;
+    spec.kind = 'S';
+    spec.depth = m_readAheadDepth >= 2 ? m_readAheadDepth : 0;
+    return spec;
 }
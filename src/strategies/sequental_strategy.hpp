@@ -14,9 +14,26 @@ namespace ss {
  */
 class SequentalHashStrategy : public AbstractHashStrategy
 {
+public:
+    /**
+     * @param readAheadDepth - count of batch buffers for overlapped I/O: background thread reads next
+     * batches while current one is hashed. < 2 => no background reads
+     */
+    SequentalHashStrategy(size_t readAheadDepth = 0);
+
 private:
+    size_t m_readAheadDepth = 0;
+
     void doHash(const Configuration& config) override;
-    std::string getConfigurationStringRepresentation() const override;
+    ss::StrategySpec getConfigurationSpec(const Configuration &config) const override;
+
+    /**
+     * @brief overlapped reads depth, lowered while buffers of all slot readers do not fit memory budget at once:
+     * reader thread waits for budget which only hashed slots could free, but they hold own buffers
+     */
+    size_t fitReadAheadDepth(const Configuration& config) const;
+
+    void hashOverlapped(const Configuration& config, size_t readAheadDepth);
 };
 
 } // ns ss
@@ -0,0 +1,275 @@
+#include "strategy_spec.hpp"
+
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+
+#include "misc.hpp"
+#include "consts.hpp"
+
+
+namespace {
+
+/// keys of full form spec, by strategy kinds
+constexpr const char* kSequentalKeys[] = {"depth", "io"};
+constexpr const char* kThreadedKeys[] = {"threads", "range", "io", "prefetch", "drop-behind", "uring-depth", "uring-buffers"};
+constexpr const char* kPipelineKeys[] = {"readers", "hashers", "range", "read", "io"};
+constexpr const char* kSingleStreamKeys[] = {"hashers", "range", "read", "io"};
+
+
+template<size_t N>
+bool contains(const char* const (&keys)[N], const std::string& key)
+{
+    for(const char* currKey : keys) {
+        if (key == currKey) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool isKeySupported(char kind, const std::string& key)
+{
+    switch (kind) {
+    case 'S':
+        return contains(kSequentalKeys, key);
+    case 'T':
+    case 'A':
+        return contains(kThreadedKeys, key);
+    case 'P':
+        return contains(kPipelineKeys, key);
+    case 'H':
+        return contains(kSingleStreamKeys, key);
+    }
+    return false;
+}
+
+
+bool isDigits(const std::string& text)
+{
+    return !text.empty() && text.find_first_not_of("0123456789") == std::string::npos;
+}
+
+
+size_t parseCount(const std::string& key, const std::string& value, size_t maxValue = std::numeric_limits<size_t>::max())
+{
+    if (!isDigits(value)) {
+        throw std::runtime_error("strategy spec: " + key + ": not a number: " + value);
+    }
+
+    unsigned long long res = 0;
+    try {
+        res = std::stoull(value);
+    } catch (const std::out_of_range&) {
+        throw std::runtime_error("strategy spec: " + key + ": value is too big: " + value);
+    }
+    if (res > maxValue) {
+        throw std::runtime_error("strategy spec: " + key + ": value is greater then maximal "
+                                 + std::to_string(maxValue) + ": " + value);
+    }
+    return static_cast<size_t>(res);
+}
+
+
+ss::SizeBytes parseSize(const std::string& key, const std::string& value)
+{
+    const bool hasSuffix = !value.empty() && std::strchr("kKmMgG", value.back()) != nullptr;
+    const std::string digits = hasSuffix ? value.substr(0, value.size() - 1) : value;
+    if (!isDigits(digits) || digits.size() > std::numeric_limits<ss::SizeBytes>::digits10) {
+        throw std::runtime_error("strategy spec: " + key + ": not a size: " + value);
+    }
+
+    const ss::SizeBytes res = misc::parseBlockSize(value);
+    if (res > ss::kMaxFileSizeBytes) {
+        throw std::runtime_error("strategy spec: " + key + ": size is greater then maximal: " + value);
+    }
+    return res;
+}
+
+
+bool parseFlag(const std::string& key, const std::string& value)
+{
+    if (value.empty() || value == "1" || value == "true") {
+        return true;
+    }
+    if (value == "0" || value == "false") {
+        return false;
+    }
+    throw std::runtime_error("strategy spec: " + key + ": not a flag: " + value);
+}
+
+
+void parseKeyValue(ss::StrategySpec& spec, const std::string& key, const std::string& value)
+{
+    if (!isKeySupported(spec.kind, key)) {
+        throw std::runtime_error(std::string("strategy spec: unknown key of strategy ") + spec.kind + ": " + key);
+    }
+
+    if (key == "depth") {
+        spec.depth = parseCount(key, value, ss::kMaxStrategyThreadsCount);
+    } else if (key == "threads") {
+        spec.threads = parseCount(key, value, ss::kMaxStrategyThreadsCount);
+    } else if (key == "readers") {
+        spec.readers = parseCount(key, value, ss::kMaxStrategyThreadsCount);
+    } else if (key == "hashers") {
+        spec.hashers = parseCount(key, value, ss::kMaxStrategyThreadsCount);
+    } else if (key == "range") {
+        spec.range = parseSize(key, value);
+    } else if (key == "read") {
+        spec.read = parseSize(key, value);
+    } else if (key == "io") {
+        spec.io = misc::parseReaderType(value);
+    } else if (key == "prefetch") {
+        spec.prefetch = parseCount(key, value);
+    } else if (key == "drop-behind") {
+        spec.dropBehind = parseFlag(key, value);
+    } else if (key == "uring-depth") {
+        spec.uringDepth = parseCount(key, value);
+    } else if (key == "uring-buffers") {
+        spec.uringBuffers = parseCount(key, value);
+    }
+}
+
+
+void parseFullForm(ss::StrategySpec& spec, const std::string& text)
+{
+    size_t start = 0;
+    while (start <= text.size()) {
+        const size_t end = std::min(text.find(',', start), text.size());
+        const std::string item = text.substr(start, end - start);
+        if (item.empty()) {
+            throw std::runtime_error("strategy spec: empty parameter");
+        }
+
+        const size_t valuePos = item.find('=');
+        const std::string key = item.substr(0, valuePos);
+        const std::string value = valuePos == std::string::npos ? std::string() : item.substr(valuePos + 1);
+        parseKeyValue(spec, key, value);
+
+        start = end + 1;
+    }
+}
+
+
+void parseShortForm(ss::StrategySpec& spec, const std::string& text)
+{
+    if (text.empty()) {
+        return;
+    }
+
+    switch (spec.kind) {
+    case 'S':
+        spec.depth = parseCount("depth", text, ss::kMaxStrategyThreadsCount);
+        return;
+    case 'H':
+        spec.hashers = parseCount("hashers", text, ss::kMaxStrategyThreadsCount);
+        return;
+    case 'P': {
+        // P[readers[:hashers]]
+        const auto delimiterPos = text.find(':');
+        const std::string readersText = text.substr(0, delimiterPos);
+        if (!readersText.empty()) {
+            spec.readers = parseCount("readers", readersText, ss::kMaxStrategyThreadsCount);
+        }
+        if (delimiterPos != std::string::npos) {
+            spec.hashers = parseCount("hashers", text.substr(delimiterPos + 1), ss::kMaxStrategyThreadsCount);
+        }
+        return;
+    }
+    case 'T':
+    case 'A':
+        if (isDigits(text)) {
+            spec.threads = parseCount("threads", text, ss::kMaxStrategyThreadsCount);
+        } else {
+            // legacy: T<digit><range size>
+            spec.threads = parseCount("threads", text.substr(0, 1), ss::kMaxStrategyThreadsCount);
+            spec.range = parseSize("range", text.substr(1));
+        }
+        return;
+    }
+}
+
+} // ns anonymous
+
+
+ss::StrategySpec ss::StrategySpec::parse(const std::string& text)
+{
+    StrategySpec res;
+    if (text.empty()) {
+        return res;
+    }
+
+    res.kind = text[0];
+    if (std::strchr("STAPH", res.kind) == nullptr) {
+        throw std::runtime_error("unknown strategy: " + text);
+    }
+
+    if (text.size() > 1 && text[1] == ':') {
+        parseFullForm(res, text.substr(2));
+    } else {
+        parseShortForm(res, text.substr(1));
+    }
+    return res;
+}
+
+
+std::string ss::StrategySpec::toString() const
+{
+    if (!isForced()) {
+        return "auto";
+    }
+
+    std::string res(1, kind);
+    const auto add = [&res](const char* key, const std::string& value) {
+        res += res.size() == 1 ? ':' : ',';
+        res += key;
+        res += '=';
+        res += value;
+    };
+
+    switch (kind) {
+    case 'S':
+        add("depth", std::to_string(depth));
+        break;
+    case 'T':
+    case 'A':
+        add("threads", std::to_string(threads));
+        add("range", std::to_string(range));
+        break;
+    case 'P':
+        add("readers", std::to_string(readers));
+        add("hashers", std::to_string(hashers));
+        add("range", std::to_string(range));
+        add("read", std::to_string(read));
+        break;
+    case 'H':
+        add("hashers", std::to_string(hashers));
+        add("range", std::to_string(range));
+        add("read", std::to_string(read));
+        break;
+    }
+
+    if (io) {
+        add("io", misc::readerTypeName(*io));
+    }
+    if (prefetch) {
+        add("prefetch", std::to_string(*prefetch));
+    }
+    if (dropBehind) {
+        add("drop-behind", *dropBehind ? "1" : "0");
+    }
+    if (uringDepth) {
+        add("uring-depth", std::to_string(*uringDepth));
+    }
+    if (uringBuffers) {
+        add("uring-buffers", std::to_string(*uringBuffers));
+    }
+    return res;
+}
+
+
+bool ss::StrategySpec::isForced() const
+{
+    return kind != 0;
+}
@@ -0,0 +1,53 @@
+#ifndef SS_STRATEGIES_STRATEGY_SPEC_H
+#define SS_STRATEGIES_STRATEGY_SPEC_H
+#pragma once
+
+#include <string>
+#include <optional>
+
+#include "types.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Forced strategy specification: <kind>[:<key>=<value>[,<key>=<value>...]], e.g. T:threads=48,range=8M,io=uring
+ * Short forms are supported too: S[d] | T[n] | A[n] | P[r[:h]] | H[h], legacy T<d><size> | A<d><size> - one digit threads count and range size
+ * Strategy knobs: 0 => autochoose. I/O knobs: not set => taken from cli options
+ */
+struct StrategySpec {
+    /// S | T | A | P | H, 0 => autochoose strategy
+    char kind = 0;
+
+    size_t depth = 0;           ///< S: overlapped reads depth (count of batch buffers)
+    size_t threads = 0;         ///< T, A: threads count
+    size_t readers = 0;         ///< P: reading threads count
+    size_t hashers = 0;         ///< P, H: hashing threads count
+    SizeBytes range = 0;        ///< T, A: range size of single job, P, H: range size hashed by single thread at once
+    SizeBytes read = 0;         ///< P, H: size of single read
+
+    std::optional<ReaderType> io;               ///< any: file reader
+    std::optional<size_t> prefetch;             ///< T, A: count of ranges to prefetch
+    std::optional<bool> dropBehind;             ///< T, A: drop hashed ranges from OS page cache
+    std::optional<size_t> uringDepth;           ///< T, A: io_uring max reads in flight
+    std::optional<size_t> uringBuffers;         ///< T, A: io_uring count of range buffers
+
+    /**
+     * @brief do parse and validate spec, empty text => autochoose
+     * @throws std::runtime_error on syntax error, unknown key or value out of range
+     */
+    static StrategySpec parse(const std::string& text);
+
+    /**
+     * @brief full form text of given spec, only set keys are printed
+     */
+    std::string toString() const;
+
+    bool isForced() const;
+};
+
+
+} // ns ss
+
+#endif // SS_STRATEGIES_STRATEGY_SPEC_H
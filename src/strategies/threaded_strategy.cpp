@@ -2,15 +2,14 @@
 
 #include <thread>
 
-#include <tools/formatter.hpp>
-
 #include "consts.hpp"
 #include "strategies/detail/threaded/processor.hpp"
 
 
-ss::ThreadedHashStrategy::ThreadedHashStrategy(size_t poolSizeHint, SizeBytes singleThreadSequentalRangeSize)
+ss::ThreadedHashStrategy::ThreadedHashStrategy(size_t poolSizeHint, SizeBytes singleThreadSequentalRangeSize, bool isAdaptive)
     : m_poolSizeHint(poolSizeHint)
     , m_singleThreadSequentalRangeSize(singleThreadSequentalRangeSize)
+    , m_isAdaptive(isAdaptive)
 {
     if (m_poolSizeHint == 0) {
         m_poolSizeHint = std::thread::hardware_concurrency();
@@ -19,6 +18,14 @@ ss::ThreadedHashStrategy::ThreadedHashStrategy(size_t poolSizeHint, SizeBytes si
 
 
 void ss::ThreadedHashStrategy::doHash(const Configuration &config)
+{
+    ss::detail::threaded::ThreadedHashProcessor ctx(config, m_poolSizeHint, effectiveRangeSize(config), m_isAdaptive);
+
+    ctx.run(config.writer);
+}
+
+
+ss::SizeBytes ss::ThreadedHashStrategy::effectiveRangeSize(const Configuration &config) const
 {
     SizeBytes effSingleThreadSequentalRangeSize = m_singleThreadSequentalRangeSize > 0
             ? m_singleThreadSequentalRangeSize
@@ -27,16 +34,20 @@ void ss::ThreadedHashStrategy::doHash(const Configuration &config)
     if (effSingleThreadSequentalRangeSize == 0) {
         effSingleThreadSequentalRangeSize = ss::kDefaultSingleThreadSequentalRangeSize;
     }
-
-    ss::detail::threaded::ThreadedHashProcessor ctx(config, m_poolSizeHint, effSingleThreadSequentalRangeSize);
-
-    ctx.run(config.writer);
+    return effSingleThreadSequentalRangeSize;
 }
 
 
-std::string ss::ThreadedHashStrategy::getConfigurationStringRepresentation() const
+ss::StrategySpec ss::ThreadedHashStrategy::getConfigurationSpec(const Configuration &config) const
 {
-    return tools::Formatter().format("T:%d:%lld",
-                                     m_poolSizeHint,
-                                     m_singleThreadSequentalRangeSize).str();
+    StrategySpec spec;
+    spec.kind = m_isAdaptive ? 'A' : 'T';
+    spec.threads = m_poolSizeHint;
+    spec.range = effectiveRangeSize(config);
+    // no hints file => hints are disabled
+    spec.prefetch = config.prefetch.file ? config.prefetch.rangesAhead : 0;
+    spec.dropBehind = config.prefetch.file && config.prefetch.dropBehind;
+    spec.uringDepth = config.asyncReads.queueDepth;
+    spec.uringBuffers = config.asyncReads.buffersCount;
+    return spec;
 }
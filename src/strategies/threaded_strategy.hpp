@@ -16,15 +16,18 @@ public:
     /**
      * @param poolSizeHint - hint to use special threads count. 0 => autochoose
      * @param singleThreadSequentalRangeSize - hint for cont. range size in bytes for single thread to process. 0 - autochoose
+     * @param isAdaptive - tune threads count and range size while running, hints are initial values
      */
-    ThreadedHashStrategy(size_t poolSizeHint = 0, SizeBytes singleThreadSequentalRangeSize = 0);
+    ThreadedHashStrategy(size_t poolSizeHint = 0, SizeBytes singleThreadSequentalRangeSize = 0, bool isAdaptive = false);
     static void setSingleThreadSequentalRangeSize(SizeBytes size);
 private:
     size_t m_poolSizeHint = 0;
     SizeBytes m_singleThreadSequentalRangeSize = 0;
+    bool m_isAdaptive = false;
 
     void doHash(const Configuration &config) override;
-    std::string getConfigurationStringRepresentation() const override;
+    ss::StrategySpec getConfigurationSpec(const Configuration &config) const override;
+    SizeBytes effectiveRangeSize(const Configuration &config) const;
 };
 
 } // ns ss
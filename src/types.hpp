@@ -4,6 +4,9 @@
 
 // simple types
 
+#include <string>
+#include <cstddef>
+
 #include <tools/types.hpp>
 
 namespace ss {
@@ -11,6 +14,22 @@ namespace ss {
 using SizeBytes = tools::SizeBytes;
 using Byte = tools::Byte;
 
+/// file block reader implementations @see reader.hpp, readers/
+enum class ReaderType {
+    Auto,
+    Stream,     ///< std::ifstream based, portable
+    ZeroCopy,   ///< pread chunks, blocks are views to chunk
+    Pread,      ///< pread of exactly requested ranges, no read-ahead
+    Direct,     ///< O_DIRECT aligned reads, bypass OS page cache
+    Uring,      ///< io_uring asynchronous reads with queue of requests in flight (threaded strategy)
+};
+
+/// signature file formats @see writers/
+enum class OutputFormat {
+    Text,       ///< hex digest per line
+    Binary,     ///< header and packed raw digests, seekable by block index
+};
+
 enum class MediaType {
     Unknown,
     Memory,
@@ -19,6 +38,21 @@ enum class MediaType {
     NetworkDrive,
 };
 
+/// identity of device holding a file, key of device profiles @see device_profiles.hpp
+struct DeviceIdentity {
+    std::string id;             ///< major:minor of file system device
+    std::string model;          ///< disk model or file system description if not a disk
+    bool isRotational = false;
+};
+
+/// tuned I/O parameters of device, found by calibration @see device_probe.hpp
+struct DeviceProfile {
+    SizeBytes readSizeBytes = 0;
+    size_t threadsCount = 1;    ///< concurrent read streams
+    size_t queueDepth = 1;      ///< reads in flight per stream, > 1 => io_uring
+    double throughputBytesPerSecond = 0.0;
+};
+
 } // ns ss
 
 #endif // SS_TYPES_H
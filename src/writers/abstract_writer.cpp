@@ -1,5 +1,7 @@
 #include "abstract_writer.hpp"
 
+#include <stdexcept>
+
 
 void ss::AstractDigestWriter::write(const tools::hash::Digest &digest)
 {
@@ -7,13 +9,67 @@ void ss::AstractDigestWriter::write(const tools::hash::Digest &digest)
 }
 
 
+void ss::AstractDigestWriter::write(const tools::hash::Digest *digests, size_t count)
+{
+    doWriteMany(digests, count);
+}
+
+
 void ss::AstractDigestWriter::flush()
 {
     doFlush();
 }
 
 
+bool ss::AstractDigestWriter::isPositional() const
+{
+    return doIsPositional();
+}
+
+
+void ss::AstractDigestWriter::writeAt(size_t firstBlockIndex, const tools::hash::Digest *digests, size_t count)
+{
+    doWriteAt(firstBlockIndex, digests, count);
+}
+
+
+bool ss::AstractDigestWriter::isStopRequested() const
+{
+    return doIsStopRequested();
+}
+
+
 void ss::AstractDigestWriter::doFlush()
 {
     // default: nothing
 }
+
+
+void ss::AstractDigestWriter::doWriteMany(const tools::hash::Digest *digests, size_t count)
+{
+    // default: one by one
+    for(size_t i = 0; i < count; ++i) {
+        doWrite(digests[i]);
+    }
+}
+
+
+bool ss::AstractDigestWriter::doIsPositional() const
+{
+    return false;
+}
+
+
+void ss::AstractDigestWriter::doWriteAt(size_t firstBlockIndex, const tools::hash::Digest *digests, size_t count)
+{
+    (void)firstBlockIndex;
+    (void)digests;
+    (void)count;
+    throw std::logic_error("writer does not support positional writes");
+}
+
+
+bool ss::AstractDigestWriter::doIsStopRequested() const
+{
+    return false;
+}
@@ -16,11 +16,33 @@ public:
 
     /// push digest to output
     void write(const tools::hash::Digest& digest);
+    /// push digests of sequental blocks to output
+    void write(const tools::hash::Digest* digests, size_t count);
     /// do any flushing for buffered outputs
     void flush();
+
+    /// writer of fixed size records at blocks offsets @see writeAt
+    bool isPositional() const;
+    /**
+     * @brief write digests of sequental blocks at their offsets, ranges may be written in any order
+     * MT: thread-safe for not overlapped ranges
+     * @throws std::logic_error if writer is not positional
+     */
+    void writeAt(size_t firstBlockIndex, const tools::hash::Digest* digests, size_t count);
+
+    /**
+     * @brief writer needs no more digests (e.g. verification already failed) => strategies stop hashing,
+     * not written blocks are skipped
+     * MT: thread-safe
+     */
+    bool isStopRequested() const;
 private:
     virtual void doWrite(const tools::hash::Digest& digest) = 0;
+    virtual void doWriteMany(const tools::hash::Digest* digests, size_t count);
     virtual void doFlush();
+    virtual bool doIsPositional() const;
+    virtual void doWriteAt(size_t firstBlockIndex, const tools::hash::Digest* digests, size_t count);
+    virtual bool doIsStopRequested() const;
 };
 
 
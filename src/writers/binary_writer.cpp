@@ -0,0 +1,133 @@
+#include "binary_writer.hpp"
+
+#include <stdexcept>
+#include <cassert>
+#include <cstring>
+
+
+namespace {
+
+constexpr const size_t kVersionOffset = 4;
+constexpr const size_t kAlgorithmOffset = 6;
+constexpr const size_t kDigestSizeOffset = 8;
+constexpr const size_t kBlockSizeOffset = 16;
+constexpr const size_t kFileSizeOffset = 24;
+constexpr const size_t kBlockCountOffset = 32;
+
+
+template<typename T>
+void putLittleEndian(std::string& data, size_t offset, T value)
+{
+    for(size_t i = 0; i < sizeof(T); ++i) {
+        data[offset + i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+}
+
+
+template<typename T>
+T getLittleEndian(std::string_view data, size_t offset)
+{
+    uint64_t res = 0;
+    for(size_t i = 0; i < sizeof(T); ++i) {
+        res |= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+    }
+    return static_cast<T>(res);
+}
+
+} // ns anonymous
+
+
+ss::BinarySignatureHeader::BinarySignatureHeader(const FileSlicesScheme &slices, Algorithm algorithm, size_t digestSize)
+    : algorithm(algorithm)
+    , digestSize(static_cast<uint32_t>(digestSize))
+    , blockSize(static_cast<uint64_t>(slices.blockSizeBytes))
+    , fileSize(static_cast<uint64_t>(slices.fileSizeBytes))
+    , blockCount(slices.blockCount)
+{
+}
+
+
+std::string ss::BinarySignatureHeader::serialize() const
+{
+    std::string res(kSize, '\0');
+    std::memcpy(res.data(), kMagic, sizeof(kMagic));
+    putLittleEndian(res, kVersionOffset, version);
+    putLittleEndian(res, kAlgorithmOffset, algorithm);
+    putLittleEndian(res, kDigestSizeOffset, digestSize);
+    putLittleEndian(res, kBlockSizeOffset, blockSize);
+    putLittleEndian(res, kFileSizeOffset, fileSize);
+    putLittleEndian(res, kBlockCountOffset, blockCount);
+    return res;
+}
+
+
+ss::BinarySignatureHeader ss::BinarySignatureHeader::parse(std::string_view data)
+{
+    if (data.size() < kSize || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("not a binary signature");
+    }
+
+    BinarySignatureHeader res;
+    res.version = getLittleEndian<uint16_t>(data, kVersionOffset);
+    if (res.version != kVersion) {
+        throw std::runtime_error("binary signature version is not supported: " + std::to_string(res.version));
+    }
+    res.algorithm = getLittleEndian<uint16_t>(data, kAlgorithmOffset);
+    res.digestSize = getLittleEndian<uint32_t>(data, kDigestSizeOffset);
+    res.blockSize = getLittleEndian<uint64_t>(data, kBlockSizeOffset);
+    res.fileSize = getLittleEndian<uint64_t>(data, kFileSizeOffset);
+    res.blockCount = getLittleEndian<uint64_t>(data, kBlockCountOffset);
+    return res;
+}
+
+
+uint64_t ss::BinarySignatureHeader::digestOffset(size_t blockIndex) const
+{
+    return kSize + static_cast<uint64_t>(blockIndex) * digestSize;
+}
+
+
+ss::BinaryStreamDigestWriter::BinaryStreamDigestWriter(std::ostream *outputStream, const BinarySignatureHeader &header)
+    : m_header(header)
+{
+    setOutputStream(outputStream);
+}
+
+
+ss::BinaryStreamDigestWriter::BinaryStreamDigestWriter(const BinarySignatureHeader &header)
+    : m_header(header)
+{
+}
+
+
+void ss::BinaryStreamDigestWriter::setOutputStream(std::ostream *outputStream)
+{
+    m_outputStream = outputStream;
+    const std::string header = m_header.serialize();
+    m_outputStream->write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+
+void ss::BinaryStreamDigestWriter::doWrite(const tools::hash::Digest &digest)
+{
+    assert(digest.size() == m_header.digestSize && "digest size differs from header one");
+    m_outputStream->write(reinterpret_cast<const char*>(digest.data()), static_cast<std::streamsize>(digest.size()));
+}
+
+
+void ss::BinaryStreamDigestWriter::doFlush()
+{
+    m_outputStream->flush();
+}
+
+
+ss::BinaryFileDigestWriter::BinaryFileDigestWriter(const std::string &outputFilePath, const BinarySignatureHeader &header)
+    : BinaryStreamDigestWriter(header)
+    , m_fileOutputStream(outputFilePath, std::ios_base::trunc | std::ios_base::binary)
+{
+    if (!m_fileOutputStream.is_open()) {
+        throw std::runtime_error("failed to open output file: " + outputFilePath);
+    }
+
+    setOutputStream(&m_fileOutputStream);
+}
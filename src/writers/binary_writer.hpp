@@ -0,0 +1,106 @@
+#ifndef SS_WRITERS_BINARY_WRITER_H
+#define SS_WRITERS_BINARY_WRITER_H
+#pragma once
+
+#include <ostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "types.hpp"
+#include "slices_scheme.hpp"
+#include "writers/abstract_writer.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Header of binary signature: fixed size, little-endian, followed by packed raw digests,
+ * so digest of block i is at offset kSize + i * digestSize
+ *
+ * | offset | size | field                     |
+ * |--------|------|---------------------------|
+ * |      0 |    4 | magic "SSIG"              |
+ * |      4 |    2 | version                   |
+ * |      6 |    2 | hash algorithm (1 - MD5)  |
+ * |      8 |    4 | digest size               |
+ * |     12 |    4 | reserved, 0               |
+ * |     16 |    8 | block size                |
+ * |     24 |    8 | file size                 |
+ * |     32 |    8 | block count               |
+ */
+struct BinarySignatureHeader {
+    static constexpr const char kMagic[4] = {'S', 'S', 'I', 'G'};
+    static constexpr const uint16_t kVersion = 1;
+    static constexpr const size_t kSize = 40;
+
+    enum Algorithm : uint16_t {
+        MD5 = 1,
+    };
+
+    uint16_t version = kVersion;
+    uint16_t algorithm = MD5;
+    uint32_t digestSize = 0;
+    uint64_t blockSize = 0;
+    uint64_t fileSize = 0;
+    uint64_t blockCount = 0;
+
+    BinarySignatureHeader() = default;
+    BinarySignatureHeader(const FileSlicesScheme& slices, Algorithm algorithm, size_t digestSize);
+
+    /**
+     * @return kSize bytes
+     */
+    std::string serialize() const;
+
+    /**
+     * @param data - at least kSize bytes
+     * @throws std::runtime_error if it is not binary signature or its version is not supported
+     */
+    static BinarySignatureHeader parse(std::string_view data);
+
+    /**
+     * @brief offset of digest of given block in binary signature
+     */
+    uint64_t digestOffset(size_t blockIndex) const;
+};
+
+
+/**
+ * @brief Binary signature writer: header and packed raw digests @see BinarySignatureHeader
+ */
+class BinaryStreamDigestWriter : public ss::AstractDigestWriter
+{
+public:
+    /**
+     * @param outputStream - binary mode stream, header is written at once
+     */
+    BinaryStreamDigestWriter(std::ostream* outputStream, const BinarySignatureHeader& header);
+protected:
+    /// for derived ones which own stream, header is written by setOutputStream
+    explicit BinaryStreamDigestWriter(const BinarySignatureHeader& header);
+    void setOutputStream(std::ostream* outputStream);
+private:
+    void doWrite(const tools::hash::Digest& digest) override;
+    void doFlush() override;
+
+    std::ostream* m_outputStream = nullptr;
+    BinarySignatureHeader m_header;
+};
+
+
+class BinaryFileDigestWriter : public BinaryStreamDigestWriter
+{
+public:
+    BinaryFileDigestWriter(const std::string& outputFilePath, const BinarySignatureHeader& header);
+private:
+    std::ofstream m_fileOutputStream;
+};
+
+
+} // ns ss
+
+
+#endif // SS_WRITERS_BINARY_WRITER_H
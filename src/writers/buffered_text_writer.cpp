@@ -0,0 +1,131 @@
+#include "buffered_text_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <tools/hash/hex.hpp>
+
+#include "consts.hpp"
+
+
+namespace {
+
+/// buffer holds at least this count of lines of longest digests
+constexpr const size_t kMinBufferLinesCount = 128;
+
+} // ns anonymous
+
+
+ss::BufferedTextDigestWriter::BufferedTextDigestWriter(const std::string &outputFilePath, const MemoryBudgetPtr &memoryBudget)
+{
+#ifdef _WIN32
+    (void)outputFilePath;
+    (void)memoryBudget;
+    throw std::runtime_error("buffered text writer is not supported on this platform");
+#else
+    if (outputFilePath.empty()) {
+        m_fd = STDOUT_FILENO;
+    } else {
+        m_fd = ::open(outputFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            const int error = errno;
+            throw std::system_error(error, std::generic_category(), "failed to open output file: " + outputFilePath);
+        }
+        m_isOwnFd = true;
+    }
+
+    SizeBytes bufferSize = ss::kTextWriterBufferSizeBytes;
+    if (memoryBudget) {
+        bufferSize = std::min(bufferSize, memoryBudget->limit() / ss::kMaxReadBufferMemoryLimitShare);
+    }
+    bufferSize = std::max<SizeBytes>(bufferSize, kMinBufferLinesCount * (2 * tools::hash::Digest::kMaxSize + 1));
+
+    if (memoryBudget) {
+        memoryBudget->reserve(bufferSize);
+        m_memoryBudget = memoryBudget;
+    }
+    m_buffer.resize(static_cast<size_t>(bufferSize));
+#endif
+}
+
+
+ss::BufferedTextDigestWriter::~BufferedTextDigestWriter() noexcept
+{
+    try {
+        writeBuffer();
+    } catch (...) {
+    }
+
+#ifndef _WIN32
+    if (m_isOwnFd) {
+        ::close(m_fd);
+    }
+#endif
+
+    if (m_memoryBudget) {
+        m_memoryBudget->unreserve(static_cast<SizeBytes>(m_buffer.size()));
+    }
+}
+
+
+void ss::BufferedTextDigestWriter::doWrite(const tools::hash::Digest &digest)
+{
+    doWriteMany(&digest, 1);
+}
+
+
+void ss::BufferedTextDigestWriter::doWriteMany(const tools::hash::Digest *digests, size_t count)
+{
+    while (count > 0) {
+        // whole batch is encoded at once while it fits buffer
+        size_t fitCount = 0;
+        size_t fitSize = m_bufferedSize;
+        while (fitCount < count && fitSize + tools::hash::hexLineSize(digests[fitCount]) <= m_buffer.size()) {
+            fitSize += tools::hash::hexLineSize(digests[fitCount]);
+            ++fitCount;
+        }
+
+        if (fitCount == 0) {
+            writeBuffer();
+            continue;
+        }
+
+        m_bufferedSize += tools::hash::encodeHexLines(digests, fitCount, m_buffer.data() + m_bufferedSize);
+        digests += fitCount;
+        count -= fitCount;
+    }
+}
+
+
+void ss::BufferedTextDigestWriter::doFlush()
+{
+    writeBuffer();
+}
+
+
+void ss::BufferedTextDigestWriter::writeBuffer()
+{
+#ifndef _WIN32
+    size_t writtenSize = 0;
+    while (writtenSize < m_bufferedSize) {
+        const ssize_t res = ::write(m_fd, m_buffer.data() + writtenSize, m_bufferedSize - writtenSize);
+        if (res < 0) {
+            const int error = errno;
+            if (error == EINTR) {
+                continue;
+            }
+            m_bufferedSize = 0;
+            throw std::system_error(error, std::generic_category(), "failed to write signature");
+        }
+        writtenSize += static_cast<size_t>(res);
+    }
+#endif
+    m_bufferedSize = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef SS_WRITERS_BUFFERED_TEXT_WRITER_H
+#define SS_WRITERS_BUFFERED_TEXT_WRITER_H
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "writers/abstract_writer.hpp"
+#include "memory_budget.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Text signature writer (same bytes as StreamDigestWriter): digests are encoded to hex
+ * by batches into large buffer (@see tools::hash::encodeHexLines), which is written by write(2)
+ * POSIX only
+ */
+class BufferedTextDigestWriter : public ss::AstractDigestWriter
+{
+public:
+    BufferedTextDigestWriter(const BufferedTextDigestWriter&) = delete;
+    BufferedTextDigestWriter(BufferedTextDigestWriter&&) = delete;
+    BufferedTextDigestWriter& operator=(const BufferedTextDigestWriter&) = delete;
+    BufferedTextDigestWriter& operator=(BufferedTextDigestWriter&&) = delete;
+
+    /**
+     * @param outputFilePath - file to create or truncate, empty => stdout
+     * @param memoryBudget - [optional] buffer is reserved in it, its size is limited by budget
+     * @throws std::system_error on open failure
+     */
+    BufferedTextDigestWriter(const std::string& outputFilePath, const MemoryBudgetPtr& memoryBudget = nullptr);
+
+    /// buffered text is written, errors are ignored - call flush() to get them
+    ~BufferedTextDigestWriter() noexcept override;
+
+private:
+    void doWrite(const tools::hash::Digest& digest) override;
+    void doWriteMany(const tools::hash::Digest* digests, size_t count) override;
+    void doFlush() override;
+
+    void writeBuffer();
+
+    int m_fd = -1;
+    bool m_isOwnFd = false;
+
+    MemoryBudgetPtr m_memoryBudget;
+    std::vector<char> m_buffer;
+    size_t m_bufferedSize = 0;
+};
+
+
+} // ns ss
+
+
+#endif // SS_WRITERS_BUFFERED_TEXT_WRITER_H
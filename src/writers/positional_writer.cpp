@@ -0,0 +1,146 @@
+#include "positional_writer.hpp"
+
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <cassert>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <tools/hash/hex.hpp>
+#include <tools/log.hpp>
+
+
+TS_LOGGER("writer.positional")
+
+
+namespace {
+
+/// records encoding buffer of calling thread, grows up to largest written range
+thread_local std::vector<char> encodedRecords;
+
+} // ns anonymous
+
+
+ss::PositionalFileDigestWriter::PositionalFileDigestWriter(const std::string &outputFilePath,
+        ss::OutputFormat format,
+        const BinarySignatureHeader &header)
+    : m_format(format)
+{
+#ifdef _WIN32
+    (void)outputFilePath;
+    (void)header;
+    throw std::runtime_error("positional writes are not supported on this platform");
+#else
+    m_recordSize = m_format == ss::OutputFormat::Binary
+            ? header.digestSize
+            : 2 * header.digestSize + 1;
+    m_recordsOffset = m_format == ss::OutputFormat::Binary
+            ? BinarySignatureHeader::kSize
+            : 0;
+
+    m_fd = ::open(outputFilePath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        const int error = errno;
+        throw std::system_error(error, std::generic_category(), "failed to open output file: " + outputFilePath);
+    }
+
+    // allocated at once => no file extension races and less fragmentation, not all file systems support it
+    const SizeBytes fileSize = m_recordsOffset + static_cast<SizeBytes>(header.blockCount) * m_recordSize;
+    const int error = ::posix_fallocate(m_fd, 0, fileSize);
+    if (error != 0) {
+        TS_DLOGF("fallocate failed: %s, file is extended by writes", std::strerror(error));
+        if (::ftruncate(m_fd, fileSize) != 0) {
+            const int truncateError = errno;
+            ::close(m_fd);
+            throw std::system_error(truncateError, std::generic_category(), "failed to allocate output file: " + outputFilePath);
+        }
+    }
+
+    if (m_format == ss::OutputFormat::Binary) {
+        const std::string headerData = header.serialize();
+        writeFullyAt(headerData.data(), headerData.size(), 0);
+    }
+#endif
+}
+
+
+ss::PositionalFileDigestWriter::~PositionalFileDigestWriter() noexcept
+{
+#ifndef _WIN32
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+
+void ss::PositionalFileDigestWriter::doWrite(const tools::hash::Digest &digest)
+{
+    doWriteMany(&digest, 1);
+}
+
+
+void ss::PositionalFileDigestWriter::doWriteMany(const tools::hash::Digest *digests, size_t count)
+{
+    doWriteAt(m_nextBlockIndex, digests, count);
+    m_nextBlockIndex += count;
+}
+
+
+bool ss::PositionalFileDigestWriter::doIsPositional() const
+{
+    return true;
+}
+
+
+void ss::PositionalFileDigestWriter::doWriteAt(size_t firstBlockIndex, const tools::hash::Digest *digests, size_t count)
+{
+    const size_t size = count * static_cast<size_t>(m_recordSize);
+    if (encodedRecords.size() < size) {
+        encodedRecords.resize(size);
+    }
+
+    if (m_format == ss::OutputFormat::Binary) {
+        char* out = encodedRecords.data();
+        for(size_t i = 0; i < count; ++i) {
+            assert(static_cast<SizeBytes>(digests[i].size()) == m_recordSize && "digest size differs from header one");
+            std::memcpy(out, digests[i].data(), digests[i].size());
+            out += digests[i].size();
+        }
+    } else {
+        const size_t encodedSize = tools::hash::encodeHexLines(digests, count, encodedRecords.data());
+        assert(encodedSize == size && "digest size differs from header one");
+        (void)encodedSize;
+    }
+
+    writeFullyAt(encodedRecords.data(), size, m_recordsOffset + static_cast<SizeBytes>(firstBlockIndex) * m_recordSize);
+}
+
+
+void ss::PositionalFileDigestWriter::writeFullyAt(const char *data, size_t size, SizeBytes offset)
+{
+#ifndef _WIN32
+    size_t writtenSize = 0;
+    while (writtenSize < size) {
+        const ssize_t res = ::pwrite(m_fd, data + writtenSize, size - writtenSize, offset + static_cast<SizeBytes>(writtenSize));
+        if (res < 0) {
+            const int error = errno;
+            if (error == EINTR) {
+                continue;
+            }
+            throw std::system_error(error, std::generic_category(), "failed to write signature");
+        }
+        writtenSize += static_cast<size_t>(res);
+    }
+#else
+    (void)data;
+    (void)size;
+    (void)offset;
+#endif
+}
@@ -0,0 +1,60 @@
+#ifndef SS_WRITERS_POSITIONAL_WRITER_H
+#define SS_WRITERS_POSITIONAL_WRITER_H
+#pragma once
+
+#include <string>
+
+#include "types.hpp"
+#include "writers/abstract_writer.hpp"
+#include "writers/binary_writer.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Signature file writer of fixed size records (text lines or binary digests): output file is
+ * preallocated for all blocks, digests of any blocks range are written by pwrite(2) at its offset,
+ * so hashing threads write own results in any order without reordering
+ * POSIX only
+ * MT: writeAt is thread-safe for not overlapped ranges, sequental write is not
+ */
+class PositionalFileDigestWriter : public ss::AstractDigestWriter
+{
+public:
+    PositionalFileDigestWriter(const PositionalFileDigestWriter&) = delete;
+    PositionalFileDigestWriter(PositionalFileDigestWriter&&) = delete;
+    PositionalFileDigestWriter& operator=(const PositionalFileDigestWriter&) = delete;
+    PositionalFileDigestWriter& operator=(PositionalFileDigestWriter&&) = delete;
+
+    /**
+     * @param outputFilePath - file to create or truncate
+     * @param format - records format, binary header is written at once
+     * @param header - blocks count and digest size of signature
+     * @throws std::system_error on open or allocation failure
+     */
+    PositionalFileDigestWriter(const std::string& outputFilePath, ss::OutputFormat format, const BinarySignatureHeader& header);
+    ~PositionalFileDigestWriter() noexcept override;
+
+private:
+    void doWrite(const tools::hash::Digest& digest) override;
+    void doWriteMany(const tools::hash::Digest* digests, size_t count) override;
+    bool doIsPositional() const override;
+    void doWriteAt(size_t firstBlockIndex, const tools::hash::Digest* digests, size_t count) override;
+
+    void writeFullyAt(const char* data, size_t size, SizeBytes offset);
+
+    int m_fd = -1;
+    ss::OutputFormat m_format;
+    SizeBytes m_recordsOffset = 0;
+    SizeBytes m_recordSize = 0;
+
+    /// sequental writes position
+    size_t m_nextBlockIndex = 0;
+};
+
+
+} // ns ss
+
+
+#endif // SS_WRITERS_POSITIONAL_WRITER_H
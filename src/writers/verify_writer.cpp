@@ -0,0 +1,232 @@
+#include "verify_writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <tools/hash/hex.hpp>
+
+#include "writers/binary_writer.hpp"
+
+
+ss::ReferenceSignature ss::ReferenceSignature::load(const std::string &signatureFilePath)
+{
+    std::ifstream input(signatureFilePath, std::ios_base::binary);
+    if (!input.is_open()) {
+        throw std::runtime_error("failed to open signature file: " + signatureFilePath);
+    }
+
+    // binary one starts with magic, text one - with hex chars
+    char magic[sizeof(BinarySignatureHeader::kMagic)] = {};
+    input.read(magic, sizeof(magic));
+    const bool isBinary = input.gcount() == sizeof(magic)
+            && std::memcmp(magic, BinarySignatureHeader::kMagic, sizeof(magic)) == 0;
+    input.clear();
+    input.seekg(0);
+
+    return isBinary ? loadBinary(input) : loadText(input);
+}
+
+
+ss::ReferenceSignature ss::ReferenceSignature::loadBinary(std::istream &input)
+{
+    std::string headerData(BinarySignatureHeader::kSize, '\0');
+    input.read(headerData.data(), static_cast<std::streamsize>(headerData.size()));
+    if (input.gcount() != static_cast<std::streamsize>(headerData.size())) {
+        throw std::runtime_error("binary signature is truncated");
+    }
+    const BinarySignatureHeader header = BinarySignatureHeader::parse(headerData);
+
+    // header is untrusted => it is checked against file scheme and rest of stream before digests allocation
+    if (header.digestSize == 0 || header.blockSize == 0) {
+        throw std::runtime_error("binary signature header is malformed");
+    }
+    const uint64_t expectedBlockCount = header.fileSize == 0
+            ? 1
+            : header.fileSize / header.blockSize + (header.fileSize % header.blockSize != 0 ? 1 : 0);
+    if (header.blockCount != expectedBlockCount) {
+        throw std::runtime_error("binary signature header is malformed: blocks count " + std::to_string(header.blockCount)
+                                 + " differs from file scheme one " + std::to_string(expectedBlockCount));
+    }
+
+    const std::streampos digestsPosition = input.tellg();
+    input.seekg(0, std::ios_base::end);
+    const uint64_t restSize = static_cast<uint64_t>(input.tellg() - digestsPosition);
+    input.seekg(digestsPosition);
+    if (header.blockCount > restSize / header.digestSize) {
+        throw std::runtime_error("binary signature is truncated");
+    }
+    if (header.blockCount * header.digestSize != restSize) {
+        throw std::runtime_error("binary signature has trailing data");
+    }
+
+    ReferenceSignature res;
+    res.m_blockCount = header.blockCount;
+    res.m_digestSize = header.digestSize;
+    res.m_blockSizeBytes = static_cast<SizeBytes>(header.blockSize);
+    res.m_digests.resize(res.m_blockCount * res.m_digestSize);
+
+    input.read(reinterpret_cast<char*>(res.m_digests.data()), static_cast<std::streamsize>(res.m_digests.size()));
+    if (input.gcount() != static_cast<std::streamsize>(res.m_digests.size())) {
+        throw std::runtime_error("binary signature is truncated");
+    }
+    return res;
+}
+
+
+ss::ReferenceSignature ss::ReferenceSignature::loadText(std::istream &input)
+{
+    ReferenceSignature res;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        // all digests have size of first one
+        if (res.m_blockCount == 0) {
+            res.m_digestSize = line.size() / 2;
+        }
+        if (line.empty() || line.size() != 2 * res.m_digestSize) {
+            throw std::runtime_error("text signature is malformed at line " + std::to_string(res.m_blockCount + 1));
+        }
+
+        res.m_digests.resize(res.m_digests.size() + res.m_digestSize);
+        if (!tools::hash::decodeHex(line, res.m_digests.data() + res.m_blockCount * res.m_digestSize)) {
+            throw std::runtime_error("text signature is malformed at line " + std::to_string(res.m_blockCount + 1));
+        }
+        ++res.m_blockCount;
+    }
+
+    if (res.m_blockCount == 0) {
+        throw std::runtime_error("signature is empty");
+    }
+    return res;
+}
+
+
+size_t ss::ReferenceSignature::blockCount() const
+{
+    return m_blockCount;
+}
+
+
+size_t ss::ReferenceSignature::digestSize() const
+{
+    return m_digestSize;
+}
+
+
+ss::SizeBytes ss::ReferenceSignature::blockSizeBytes() const
+{
+    return m_blockSizeBytes;
+}
+
+
+ss::SizeBytes ss::ReferenceSignature::sizeBytes() const
+{
+    return static_cast<SizeBytes>(m_digests.size());
+}
+
+
+const ss::Byte *ss::ReferenceSignature::digest(size_t blockIndex) const
+{
+    return m_digests.data() + blockIndex * m_digestSize;
+}
+
+
+ss::VerifyingDigestWriter::VerifyingDigestWriter(const ReferenceSignaturePtr &reference, size_t digestSize, bool isFailFast,
+        const MemoryBudgetPtr &memoryBudget)
+    : m_reference(reference)
+    , m_isFailFast(isFailFast)
+{
+    if (m_reference->digestSize() != digestSize) {
+        throw std::runtime_error("signature digest size differs: " + std::to_string(m_reference->digestSize())
+                                 + ", expected " + std::to_string(digestSize));
+    }
+
+    // NOTE: long-lived, held till the end
+    if (memoryBudget) {
+        memoryBudget->reserve(m_reference->sizeBytes());
+        m_memoryBudget = memoryBudget;
+    }
+}
+
+
+ss::VerifyingDigestWriter::~VerifyingDigestWriter() noexcept
+{
+    if (m_memoryBudget) {
+        m_memoryBudget->unreserve(m_reference->sizeBytes());
+    }
+}
+
+
+size_t ss::VerifyingDigestWriter::verifiedBlocksCount() const
+{
+    return m_verifiedBlocksCount.load(std::memory_order_acquire);
+}
+
+
+std::vector<size_t> ss::VerifyingDigestWriter::mismatchedBlocks() const
+{
+    std::vector<size_t> res;
+    {
+        std::lock_guard<std::mutex> guard(m_mutMismatches);
+        res = m_mismatchedBlocks;
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+
+void ss::VerifyingDigestWriter::doWrite(const tools::hash::Digest &digest)
+{
+    doWriteMany(&digest, 1);
+}
+
+
+void ss::VerifyingDigestWriter::doWriteMany(const tools::hash::Digest *digests, size_t count)
+{
+    doWriteAt(m_nextBlockIndex, digests, count);
+    m_nextBlockIndex += count;
+}
+
+
+bool ss::VerifyingDigestWriter::doIsPositional() const
+{
+    return true;
+}
+
+
+void ss::VerifyingDigestWriter::doWriteAt(size_t firstBlockIndex, const tools::hash::Digest *digests, size_t count)
+{
+    const size_t digestSize = m_reference->digestSize();
+    const size_t referenceBlockCount = m_reference->blockCount();
+
+    bool hasMismatches = false;
+    for(size_t i = 0; i < count; ++i) {
+        const size_t blockIndex = firstBlockIndex + i;
+        if (blockIndex < referenceBlockCount
+                && std::memcmp(digests[i].data(), m_reference->digest(blockIndex), digestSize) == 0) {
+            continue;
+        }
+
+        // mismatches are rare => lock per mismatch
+        std::lock_guard<std::mutex> guard(m_mutMismatches);
+        m_mismatchedBlocks.push_back(blockIndex);
+        hasMismatches = true;
+    }
+
+    m_verifiedBlocksCount.fetch_add(count, std::memory_order_release);
+    if (hasMismatches && m_isFailFast) {
+        m_isStopRequested.store(true, std::memory_order_release);
+    }
+}
+
+
+bool ss::VerifyingDigestWriter::doIsStopRequested() const
+{
+    return m_isStopRequested.load(std::memory_order_acquire);
+}
@@ -0,0 +1,112 @@
+#ifndef SS_WRITERS_VERIFY_WRITER_H
+#define SS_WRITERS_VERIFY_WRITER_H
+#pragma once
+
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+#include "memory_budget.hpp"
+#include "writers/abstract_writer.hpp"
+
+
+namespace ss {
+
+
+/**
+ * @brief Signature to verify file against: text or binary one (detected by binary magic),
+ * digests are stored packed, as in binary signature
+ */
+class ReferenceSignature {
+public:
+    /**
+     * @throws std::runtime_error if file can not be read or it is malformed
+     */
+    static ReferenceSignature load(const std::string& signatureFilePath);
+
+    size_t blockCount() const;
+    size_t digestSize() const;
+
+    /// block size of binary signature, 0 - unknown (text signature)
+    SizeBytes blockSizeBytes() const;
+
+    /// packed digests size
+    SizeBytes sizeBytes() const;
+
+    const Byte* digest(size_t blockIndex) const;
+
+private:
+    std::vector<Byte> m_digests;
+    size_t m_blockCount = 0;
+    size_t m_digestSize = 0;
+    SizeBytes m_blockSizeBytes = 0;
+
+    static ReferenceSignature loadBinary(std::istream& input);
+    static ReferenceSignature loadText(std::istream& input);
+};
+
+
+using ReferenceSignaturePtr = std::shared_ptr<const ReferenceSignature>;
+
+
+/**
+ * @brief Compares digests with reference signature as they are produced, nothing is written.
+ * Positional => threaded strategy jobs compare own results at once, in any order.
+ * Fail-fast: stop is requested on first mismatch @see AstractDigestWriter::isStopRequested
+ * MT: writeAt and results are thread-safe, sequental write is not
+ */
+class VerifyingDigestWriter : public ss::AstractDigestWriter
+{
+public:
+    VerifyingDigestWriter(const VerifyingDigestWriter&) = delete;
+    VerifyingDigestWriter(VerifyingDigestWriter&&) = delete;
+    VerifyingDigestWriter& operator=(const VerifyingDigestWriter&) = delete;
+    VerifyingDigestWriter& operator=(VerifyingDigestWriter&&) = delete;
+
+    /**
+     * @param reference - signature to compare with
+     * @param digestSize - digest size of hasher, must be the same as reference one
+     * @param isFailFast - request stop on first mismatch
+     * @param memoryBudget - [optional] reference digests are reserved in it
+     * @throws std::runtime_error if digest sizes differ or reference does not fit memory budget
+     */
+    VerifyingDigestWriter(const ReferenceSignaturePtr& reference, size_t digestSize, bool isFailFast,
+            const MemoryBudgetPtr& memoryBudget = nullptr);
+    ~VerifyingDigestWriter() noexcept override;
+
+    /// count of compared blocks, including ones out of reference
+    size_t verifiedBlocksCount() const;
+
+    /// sorted indices of mismatched blocks (blocks out of reference are mismatched too)
+    std::vector<size_t> mismatchedBlocks() const;
+
+private:
+    void doWrite(const tools::hash::Digest& digest) override;
+    void doWriteMany(const tools::hash::Digest* digests, size_t count) override;
+    bool doIsPositional() const override;
+    void doWriteAt(size_t firstBlockIndex, const tools::hash::Digest* digests, size_t count) override;
+    bool doIsStopRequested() const override;
+
+    const ReferenceSignaturePtr m_reference;
+    const bool m_isFailFast;
+    MemoryBudgetPtr m_memoryBudget;
+
+    std::atomic_size_t m_verifiedBlocksCount = 0;
+    std::atomic_bool m_isStopRequested = false;
+
+    mutable std::mutex m_mutMismatches;
+    std::vector<size_t> m_mismatchedBlocks;
+
+    /// sequental writes position
+    size_t m_nextBlockIndex = 0;
+};
+
+
+} // ns ss
+
+
+#endif // SS_WRITERS_VERIFY_WRITER_H